@@ -147,14 +147,14 @@ template <int N> __KFP_SIMD__INLINE float get(const __m256& a)
     return result[N];
 }
 
-// Pavel: TODO:
-// template <>
-// __KFP_SIMD__INLINE float extract<int, __m256>(int index, const __m256& a)
-// {
-//     float result[8];
-//     _mm256_storeu_ps(result, a);
-//     return result[index];
-// }
+template <>
+__KFP_SIMD__INLINE float extract<float, __m256>(int index, const __m256& a)
+{
+    float __KFP_SIMD__ATTR_ALIGN(__KFP_SIMD__Size_Float)
+        data[__KFP_SIMD__Len_Float]{}; // Helper data array
+    _mm256_store_ps(data, a);
+    return data[index];
+}
 
 // Robin: Maybe this instead:
 /*
@@ -215,7 +215,44 @@ __KFP_SIMD__INLINE __m256 divide<__m256>(const __m256& a, const __m256& b)
 }
 template <> __KFP_SIMD__INLINE __m256 minus<__m256>(const __m256& a)
 {
-    return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(0x80000000)));
+    return _mm256_xor_ps(a, _mm256_castsi256_ps(getMask<MASK::MINUS>()));
+}
+
+template <>
+__KFP_SIMD__INLINE __m256 fmadd<__m256>(const __m256& a, const __m256& b, const __m256& c)
+{
+#if defined(__FMA__)
+    return _mm256_fmadd_ps(a, b, c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+template <>
+__KFP_SIMD__INLINE __m256 fmsub<__m256>(const __m256& a, const __m256& b, const __m256& c)
+{
+#if defined(__FMA__)
+    return _mm256_fmsub_ps(a, b, c);
+#else
+    return _mm256_sub_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+template <>
+__KFP_SIMD__INLINE __m256 fnmadd<__m256>(const __m256& a, const __m256& b, const __m256& c)
+{
+#if defined(__FMA__)
+    return _mm256_fnmadd_ps(a, b, c);
+#else
+    return _mm256_sub_ps(c, _mm256_mul_ps(a, b));
+#endif
+}
+template <>
+__KFP_SIMD__INLINE __m256 fnmsub<__m256>(const __m256& a, const __m256& b, const __m256& c)
+{
+#if defined(__FMA__)
+    return _mm256_fnmsub_ps(a, b, c);
+#else
+    return minus<__m256>(_mm256_add_ps(_mm256_mul_ps(a, b), c));
+#endif
 }
 
 template <>
@@ -239,7 +276,7 @@ template <> __KFP_SIMD__INLINE __m256 rsqrt<__m256>(const __m256& a)
 }
 template <> __KFP_SIMD__INLINE __m256 abs<__m256>(const __m256& a)
 {
-    return _mm256_and_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF)));
+    return _mm256_and_ps(a, _mm256_castsi256_ps(getMask<MASK::ABS>()));
 }
 template <> __KFP_SIMD__INLINE __m256 log<__m256>(const __m256& a)
 {
@@ -14,6 +14,7 @@ Emails: mithran@fias.uni-frankfurt.de
 #include "simd_avx_type.h"
 
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 
 namespace KFP {
@@ -23,19 +24,18 @@ namespace Detail {
 
 enum class MASK { ABS, MINUS, TRUE, INF };
 
+// Masks are loaded from the shared aligned constant tables
+template <MASK mask> struct MaskBits;
+template <> struct MaskBits<MASK::ABS> { static constexpr std::uint32_t value{ 0x7FFFFFFF }; };
+template <> struct MaskBits<MASK::MINUS> { static constexpr std::uint32_t value{ 0x80000000 }; };
+template <> struct MaskBits<MASK::TRUE> { static constexpr std::uint32_t value{ 0xFFFFFFFF }; };
+template <> struct MaskBits<MASK::INF> { static constexpr std::uint32_t value{ 0x7F800000 }; };
+
 template <MASK mask>
-constexpr __KFP_SIMD__INLINE SimdDataI getMask()
+__KFP_SIMD__INLINE SimdDataI getMask()
 {
-  switch (mask) {
-  case MASK::ABS:
-    return _mm256_set1_epi32(0x7FFFFFFF);
-  case MASK::MINUS:
-    return _mm256_set1_epi32(0x80000000);
-  case MASK::TRUE:
-    return _mm256_set1_epi32(-1);
-  case MASK::INF:
-    return _mm256_set1_epi32(0x7F800000);
-  }
+  return _mm256_load_si256(reinterpret_cast<const SimdDataI*>(
+      ConstantPool<MaskBits<mask>::value, __KFP_SIMD__Len_Int, __KFP_SIMD__Size_Int>::data));
 }
 
 // ------------------------------------------------------
@@ -420,6 +420,27 @@ __KFP_SIMD__INLINE SimdDataI divide<SimdDataI>(const SimdDataI &a, const SimdDat
 template <> __KFP_SIMD__INLINE SimdDataI minus<SimdDataI>(const SimdDataI &a) {
   return substract<SimdDataI>(_mm256_setzero_si256(), a);
 }
+// No fused integer multiply-add: composed from multiply and add
+template <>
+__KFP_SIMD__INLINE SimdDataI fmadd<SimdDataI>(const SimdDataI &a, const SimdDataI &b,
+                                              const SimdDataI &c) {
+  return add<SimdDataI>(multiply<SimdDataI>(a, b), c);
+}
+template <>
+__KFP_SIMD__INLINE SimdDataI fmsub<SimdDataI>(const SimdDataI &a, const SimdDataI &b,
+                                              const SimdDataI &c) {
+  return substract<SimdDataI>(multiply<SimdDataI>(a, b), c);
+}
+template <>
+__KFP_SIMD__INLINE SimdDataI fnmadd<SimdDataI>(const SimdDataI &a, const SimdDataI &b,
+                                               const SimdDataI &c) {
+  return substract<SimdDataI>(c, multiply<SimdDataI>(a, b));
+}
+template <>
+__KFP_SIMD__INLINE SimdDataI fnmsub<SimdDataI>(const SimdDataI &a, const SimdDataI &b,
+                                               const SimdDataI &c) {
+  return minus<SimdDataI>(fmadd<SimdDataI>(a, b, c));
+}
 
 template <>
 __KFP_SIMD__INLINE SimdDataI min<SimdDataI>(const SimdDataI &a, const SimdDataI &b) {
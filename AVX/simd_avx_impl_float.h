@@ -168,6 +168,9 @@ inline void simd_float::store_partial(int n, value_type* val_ptr) const
 template <>
 inline simd_float& simd_float::gather(const value_type* val_ptr, const simd_int& index)
 {
+#if defined(__KFP_SIMD__AVX2)
+    data_.simd_ = _mm256_i32gather_ps(val_ptr, index.simd(), sizeof(value_type));
+#else
     simd_int::value_type __KFP_SIMD__ATTR_ALIGN(__KFP_SIMD__Size_Int)
         indices[__KFP_SIMD__Len_Int]{}; // Helper indices array
     Detail::store_a<simd_int::simd_type, simd_int::value_type>(index.simd(), indices);
@@ -175,6 +178,7 @@ inline simd_float& simd_float::gather(const value_type* val_ptr, const simd_int&
                                  val_ptr[indices[2]], val_ptr[indices[3]],
                                  val_ptr[indices[4]], val_ptr[indices[5]],
                                  val_ptr[indices[6]], val_ptr[indices[7]]);
+#endif
     return *this;
 }
 template <>
@@ -293,11 +297,15 @@ inline simd_float select(const simd_mask& mask, const simd_float& a, const simd_
 }
 template <typename F> inline simd_float apply(const simd_float& a, const F& func)
 {
-    simd_float::value_type __KFP_SIMD__ATTR_ALIGN(__KFP_SIMD__Size_Float)
-        data[__KFP_SIMD__Len_Float]{}; // Helper data array
-    a.store_a(data);
-    return simd_float{ _mm256_setr_ps(func(data[0]), func(data[1]), func(data[2]), func(data[3]),
-                                      func(data[4]), func(data[5]), func(data[6]), func(data[7])) };
+    if constexpr (Detail::isSimdCallable<F, simd_float>::value) {
+        return simd_float{ func(a) };
+    } else {
+        simd_float::value_type __KFP_SIMD__ATTR_ALIGN(__KFP_SIMD__Size_Float)
+            data[__KFP_SIMD__Len_Float]{}; // Helper data array
+        a.store_a(data);
+        return simd_float{ _mm256_setr_ps(func(data[0]), func(data[1]), func(data[2]), func(data[3]),
+                                          func(data[4]), func(data[5]), func(data[6]), func(data[7])) };
+    }
 }
 
 inline simd_float round(const simd_float& a)
@@ -307,13 +315,15 @@ inline simd_float round(const simd_float& a)
 
 inline simd_mask isInf(const simd_float& a)
 {
-    auto inf_mask = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    const simd_float::simd_type inf_mask =
+        Detail::type_cast<simd_float::simd_type, simd_int::simd_type>(Detail::getMask<Detail::MASK::INF>());
     return simd_mask{ _mm256_cmp_ps(a.simd(), inf_mask, _CMP_EQ_OQ) };
 }
 
 inline simd_mask isFinite(const simd_float& a)
 {
-    auto inf_mask = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    const simd_float::simd_type inf_mask =
+        Detail::type_cast<simd_float::simd_type, simd_int::simd_type>(Detail::getMask<Detail::MASK::INF>());
     return simd_mask{ _mm256_cmp_ps(a.simd(), inf_mask, _CMP_NEQ_OQ) };
 }
 
@@ -106,7 +106,7 @@ template <> inline simd_int& simd_int::load_a(const value_type* val_ptr)
     return *this;
 }
 
-// Robin: TODO: The SSE equivalent function from Akhil inserts values at the beginning, not at the end.
+// Loads the first n elements into the low lanes, as the SSE and float versions do.
 template <>
 inline simd_int& simd_int::load_partial(int n, const value_type* val_ptr)
 {
@@ -115,25 +115,25 @@ inline simd_int& simd_int::load_partial(int n, const value_type* val_ptr)
         data_.simd_ = _mm256_setzero_si256();
         break;
     case 1:
-        data_.simd_ = _mm256_set_epi32(0, 0, 0, 0, 0, 0, 0, val_ptr[0]);
+        data_.simd_ = _mm256_setr_epi32(val_ptr[0], 0, 0, 0, 0, 0, 0, 0);
         break;
     case 2:
-        data_.simd_ = _mm256_set_epi32(0, 0, 0, 0, 0, 0, val_ptr[0], val_ptr[1]);
+        data_.simd_ = _mm256_setr_epi32(val_ptr[0], val_ptr[1], 0, 0, 0, 0, 0, 0);
         break;
     case 3:
-        data_.simd_ = _mm256_set_epi32(0, 0, 0, 0, 0, val_ptr[0], val_ptr[1], val_ptr[2]);
+        data_.simd_ = _mm256_setr_epi32(val_ptr[0], val_ptr[1], val_ptr[2], 0, 0, 0, 0, 0);
         break;
     case 4:
-        data_.simd_ = _mm256_set_epi32(0, 0, 0, 0, val_ptr[0], val_ptr[1], val_ptr[2], val_ptr[3]);
+        data_.simd_ = _mm256_setr_epi32(val_ptr[0], val_ptr[1], val_ptr[2], val_ptr[3], 0, 0, 0, 0);
         break;
     case 5:
-        data_.simd_ = _mm256_set_epi32(0, 0, 0, val_ptr[0], val_ptr[1], val_ptr[2], val_ptr[3], val_ptr[4]);
+        data_.simd_ = _mm256_setr_epi32(val_ptr[0], val_ptr[1], val_ptr[2], val_ptr[3], val_ptr[4], 0, 0, 0);
         break;
     case 6:
-        data_.simd_ = _mm256_set_epi32(0, 0, val_ptr[0], val_ptr[1], val_ptr[2], val_ptr[3], val_ptr[4], val_ptr[5]);
+        data_.simd_ = _mm256_setr_epi32(val_ptr[0], val_ptr[1], val_ptr[2], val_ptr[3], val_ptr[4], val_ptr[5], 0, 0);
         break;
     case 7:
-        data_.simd_ = _mm256_set_epi32(0, val_ptr[0], val_ptr[1], val_ptr[2], val_ptr[3], val_ptr[4], val_ptr[5], val_ptr[6]);
+        data_.simd_ = _mm256_setr_epi32(val_ptr[0], val_ptr[1], val_ptr[2], val_ptr[3], val_ptr[4], val_ptr[5], val_ptr[6], 0);
         break;
     case 8:
     default:
@@ -177,12 +177,16 @@ inline void simd_int::store_partial(int n, value_type* val_ptr) const
 template <>
 inline simd_int& simd_int::gather(const value_type* val_ptr, const simd_int& index)
 {
+#if defined(__KFP_SIMD__AVX2)
+    data_.simd_ = _mm256_i32gather_epi32(val_ptr, index.data_.simd_, sizeof(value_type));
+#else
     int __KFP_SIMD__ATTR_ALIGN(__KFP_SIMD__Size_Int)
         indices[__KFP_SIMD__Len_Int]{}; // Helper indices array
     Detail::store_a<__m256i, int>(index.data_.simd_, indices);
     data_.simd_ = _mm256_setr_epi32(
         val_ptr[indices[0]], val_ptr[indices[1]], val_ptr[indices[2]], val_ptr[indices[3]],
         val_ptr[indices[4]], val_ptr[indices[5]], val_ptr[indices[6]], val_ptr[indices[7]]);
+#endif
     return *this;
 }
 
@@ -296,11 +300,15 @@ inline simd_int select(const simd_mask& mask, const simd_int& a, const simd_int&
 
 template <typename F> inline simd_int apply(const simd_int& a, const F& func)
 {
-    simd_int::value_type __KFP_SIMD__ATTR_ALIGN(__KFP_SIMD__Size_Int)
-        data[__KFP_SIMD__Len_Int]{}; // Helper data array
-    a.store_a(data);
-    return simd_int{ _mm256_setr_epi32(func(data[0]), func(data[1]), func(data[2]), func(data[3]),
-                                       func(data[4]), func(data[5]), func(data[6]), func(data[7])) };
+    if constexpr (Detail::isSimdCallable<F, simd_int>::value) {
+        return simd_int{ func(a) };
+    } else {
+        simd_int::value_type __KFP_SIMD__ATTR_ALIGN(__KFP_SIMD__Size_Int)
+            data[__KFP_SIMD__Len_Int]{}; // Helper data array
+        a.store_a(data);
+        return simd_int{ _mm256_setr_epi32(func(data[0]), func(data[1]), func(data[2]), func(data[3]),
+                                           func(data[4]), func(data[5]), func(data[6]), func(data[7])) };
+    }
 }
 
 } // namespace SIMD
@@ -19,6 +19,10 @@ Emails: mithran@fias.uni-frankfurt.de
 namespace KFP {
 namespace SIMD {
 
+template <> inline simd_mask::SimdMaskBase()
+{
+    mask_ = Detail::constant<simd_typei, value_typei>(0);
+}
 template <> inline simd_mask::SimdMaskBase(bool val)
 {
     mask_ = Detail::constant<simd_typei, value_typei>(-int(val));
@@ -111,13 +115,12 @@ template <> inline int simd_mask::count() const
 
 template <> inline bool simd_mask::AND() const
 {
-    //8 instead of 4
-    return static_cast<bool>(count() == 8);
+    return _mm256_movemask_ps(_mm256_castsi256_ps(mask_)) == 0xFF;
 }
 
 template <> inline bool simd_mask::OR() const
 {
-    return static_cast<bool>(count() != 0);
+    return not _mm256_testz_si256(mask_, mask_);
 }
 
 // ------------------------------------------------------
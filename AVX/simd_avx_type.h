@@ -12,7 +12,9 @@ Emails: mithran@fias.uni-frankfurt.de
 #include "../Base/simd_data.h"
 #include "../Base/simd_mask.h"
 #include "../Base/simd_class.h"
+#include "../Base/simd_constant.h"
 
+#include <cstdint>
 #include <type_traits>
 
 namespace KFP {
@@ -28,6 +30,9 @@ using simd_int = SimdClassBase<int, Tag::AVX>;
 static_assert(std::is_same<simd_int::value_type, int>::value,
               "[Error]: Invalid value type for AVX int SimdClass.");
 
+template <typename ValueType, std::uint32_t Bits>
+using simd_constant = SimdConstantBase<ValueType, Bits, Tag::AVX>;
+
 namespace Detail{
 
 typedef simd_int::simd_type SimdDataI;
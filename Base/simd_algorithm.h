@@ -0,0 +1,530 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_ALGORITHM_H
+#define SIMD_ALGORITHM_H
+
+#include "simd_allocate.h"
+#include "simd_class.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Algorithms over contiguous float/int ranges, processed one simd batch at a
+// time: aligned main loops when the data allows it, a masked epilogue for the
+// last partial batch and several independent accumulators for reductions.
+// Callbacks take and return simd_float/simd_int (predicates return simd_mask).
+// Included by simd.h once the backend types are defined.
+
+namespace KFP {
+namespace SIMD {
+
+namespace Detail {
+
+template <typename T> using SimdOf = SimdClassBase<T, simd_float::tag_val>;
+
+// Aligned (load_a/store_a) or unaligned (load/store) batch access
+template <bool Aligned> struct BatchAccess;
+template <> struct BatchAccess<true>
+{
+    template <typename T> static SimdOf<T> load(const T* val_ptr)
+    {
+        return SimdOf<T>{}.load_a(val_ptr);
+    }
+    template <typename T> static void store(const SimdOf<T>& val_simd, T* val_ptr)
+    {
+        val_simd.store_a(val_ptr);
+    }
+};
+template <> struct BatchAccess<false>
+{
+    template <typename T> static SimdOf<T> load(const T* val_ptr)
+    {
+        return SimdOf<T>{}.load(val_ptr);
+    }
+    template <typename T> static void store(const SimdOf<T>& val_simd, T* val_ptr)
+    {
+        val_simd.store(val_ptr);
+    }
+};
+
+template <typename T> inline bool isSimdAligned(const T* val_ptr)
+{
+    return isAligned(reinterpret_cast<std::uintptr_t>(val_ptr), SimdOf<T>::SimdSize);
+}
+
+// Vectors whose allocator alignment covers a full batch need no runtime check
+template <typename T, std::size_t Alignment>
+constexpr bool isSimdAlignedVector()
+{
+    return (Alignment % SimdOf<T>::SimdSize) == 0;
+}
+
+// Lanes [0, n) set
+inline simd_mask laneMask(int n)
+{
+    return (simd_int::iota(0) < simd_int{ n });
+}
+
+inline int firstLane(const simd_mask& mask)
+{
+    for (int iLane = 0; iLane < simd_mask::SimdLen; ++iLane) {
+        if (mask[iLane]) {
+            return iLane;
+        }
+    }
+    return simd_mask::SimdLen;
+}
+
+struct Plus
+{
+    template <typename SimdClass>
+    SimdClass operator()(const SimdClass& a, const SimdClass& b) const
+    {
+        return a + b;
+    }
+};
+struct Identity
+{
+    template <typename SimdClass> const SimdClass& operator()(const SimdClass& a) const
+    {
+        return a;
+    }
+};
+
+// Folds the first n lanes into init, one lane at a time
+template <typename T, typename BinaryOp>
+inline T foldLanes(const SimdOf<T>& val_simd, int n, T init, const BinaryOp& op)
+{
+    __KFP_SIMD__SPEC_ALIGN(SimdOf<T>::SimdSize) T data[SimdOf<T>::SimdLen]{}; // Helper data array
+    val_simd.store_a(data);
+    for (int iLane = 0; iLane < n; ++iLane) {
+        init = SimdOf<T>{ op(SimdOf<T>{ init }, SimdOf<T>{ data[iLane] }) }[0];
+    }
+    return init;
+}
+
+template <bool Aligned, typename T, typename F>
+inline void transformImpl(const T* in, T* out, std::size_t size, const F& func)
+{
+    constexpr std::size_t SimdLen = SimdOf<T>::SimdLen;
+    const std::size_t size_main = size - size % SimdLen;
+    std::size_t idx = 0;
+    for (; idx < size_main; idx += SimdLen) {
+        BatchAccess<Aligned>::store(apply(BatchAccess<Aligned>::load(in + idx), func), out + idx);
+    }
+    // Masked epilogue: the lanes past the end are loaded as zero and not stored
+    if (idx < size) {
+        const int n = static_cast<int>(size - idx);
+        apply(SimdOf<T>{}.load_partial(n, in + idx), func).store_partial(n, out + idx);
+    }
+}
+
+template <bool Aligned, typename T, typename BinaryOp, typename UnaryOp>
+inline T transformReduceImpl(const T* in, std::size_t size, T init, const BinaryOp& reduce_op,
+                             const UnaryOp& transform_op)
+{
+    using simd_type = SimdOf<T>;
+    constexpr std::size_t SimdLen = simd_type::SimdLen;
+    constexpr std::size_t Unroll = 4;
+    auto batch = [&](std::size_t idx) {
+        return simd_type{ apply(BatchAccess<Aligned>::load(in + idx), transform_op) };
+    };
+
+    std::size_t idx = 0;
+    int valid_lanes = SimdLen;
+    simd_type acc0;
+    if (size >= Unroll * SimdLen) {
+        // Four independent chains hide the latency of reduce_op
+        acc0 = batch(0);
+        simd_type acc1 = batch(SimdLen);
+        simd_type acc2 = batch(2 * SimdLen);
+        simd_type acc3 = batch(3 * SimdLen);
+        for (idx = Unroll * SimdLen; idx + Unroll * SimdLen <= size; idx += Unroll * SimdLen) {
+            acc0 = simd_type{ reduce_op(acc0, batch(idx)) };
+            acc1 = simd_type{ reduce_op(acc1, batch(idx + SimdLen)) };
+            acc2 = simd_type{ reduce_op(acc2, batch(idx + 2 * SimdLen)) };
+            acc3 = simd_type{ reduce_op(acc3, batch(idx + 3 * SimdLen)) };
+        }
+        acc0 = simd_type{ reduce_op(simd_type{ reduce_op(acc0, acc1) },
+                                    simd_type{ reduce_op(acc2, acc3) }) };
+    } else if (size >= SimdLen) {
+        acc0 = batch(0);
+        idx = SimdLen;
+    } else {
+        valid_lanes = 0;
+    }
+    for (; idx + SimdLen <= size; idx += SimdLen) {
+        acc0 = simd_type{ reduce_op(acc0, batch(idx)) };
+    }
+    // Masked epilogue: lanes past the end keep the accumulated value
+    if (idx < size) {
+        const int n = static_cast<int>(size - idx);
+        const simd_type tail{ apply(simd_type{}.load_partial(n, in + idx), transform_op) };
+        if (valid_lanes == 0) {
+            acc0 = tail;
+            valid_lanes = n;
+        } else {
+            acc0 = select(laneMask(n), simd_type{ reduce_op(acc0, tail) }, acc0);
+        }
+    }
+    return foldLanes(acc0, valid_lanes, init, reduce_op);
+}
+
+template <bool Aligned, typename T, typename Predicate>
+inline std::size_t countIfImpl(const T* in, std::size_t size, const Predicate& pred)
+{
+    constexpr std::size_t SimdLen = SimdOf<T>::SimdLen;
+    // True lanes are -1, so subtracting the mask counts per lane
+    simd_int count0{ 0 };
+    simd_int count1{ 0 };
+    std::size_t idx = 0;
+    for (; idx + 2 * SimdLen <= size; idx += 2 * SimdLen) {
+        const simd_mask mask0{ pred(BatchAccess<Aligned>::load(in + idx)) };
+        const simd_mask mask1{ pred(BatchAccess<Aligned>::load(in + idx + SimdLen)) };
+        count0 = count0 - simd_int{ mask0.maski() };
+        count1 = count1 - simd_int{ mask1.maski() };
+    }
+    for (; idx + SimdLen <= size; idx += SimdLen) {
+        const simd_mask mask{ pred(BatchAccess<Aligned>::load(in + idx)) };
+        count0 = count0 - simd_int{ mask.maski() };
+    }
+    if (idx < size) {
+        const int n = static_cast<int>(size - idx);
+        const simd_mask mask = simd_mask{ pred(SimdOf<T>{}.load_partial(n, in + idx)) } && laneMask(n);
+        count0 = count0 - simd_int{ mask.maski() };
+    }
+    return static_cast<std::size_t>(foldLanes(count0 + count1, simd_int::SimdLen, 0, Plus{}));
+}
+
+template <bool Aligned, typename T, typename Predicate>
+inline std::size_t findIfImpl(const T* in, std::size_t size, const Predicate& pred)
+{
+    constexpr std::size_t SimdLen = SimdOf<T>::SimdLen;
+    std::size_t idx = 0;
+    for (; idx + SimdLen <= size; idx += SimdLen) {
+        const simd_mask mask{ pred(BatchAccess<Aligned>::load(in + idx)) };
+        if (mask.OR()) {
+            return idx + static_cast<std::size_t>(firstLane(mask));
+        }
+    }
+    if (idx < size) {
+        const int n = static_cast<int>(size - idx);
+        const simd_mask mask = simd_mask{ pred(SimdOf<T>{}.load_partial(n, in + idx)) } && laneMask(n);
+        if (mask.OR()) {
+            return idx + static_cast<std::size_t>(firstLane(mask));
+        }
+    }
+    return size;
+}
+
+template <bool Aligned, typename T>
+inline std::pair<std::size_t, std::size_t> minmaxElementImpl(const T* in, std::size_t size)
+{
+    using simd_type = SimdOf<T>;
+    constexpr std::size_t SimdLen = simd_type::SimdLen;
+    if (size == 0) {
+        return { size, size };
+    }
+    // Per lane: the first smallest and the last largest value seen, and where
+    simd_type val_min{ in[0] };
+    simd_type val_max{ in[0] };
+    simd_int idx_min{ 0 };
+    simd_int idx_max{ 0 };
+    simd_int idx_simd = simd_int::iota(0);
+    std::size_t idx = 0;
+    for (; idx + SimdLen <= size; idx += SimdLen) {
+        const simd_type batch = BatchAccess<Aligned>::load(in + idx);
+        const simd_mask is_min = batch < val_min;
+        const simd_mask is_max = batch >= val_max;
+        val_min = select(is_min, batch, val_min);
+        idx_min = select(is_min, idx_simd, idx_min);
+        val_max = select(is_max, batch, val_max);
+        idx_max = select(is_max, idx_simd, idx_max);
+        idx_simd = idx_simd + simd_int{ simd_type::SimdLen };
+    }
+    if (idx < size) {
+        const int n = static_cast<int>(size - idx);
+        const simd_type batch = simd_type{}.load_partial(n, in + idx);
+        const simd_mask valid = laneMask(n);
+        const simd_mask is_min = (batch < val_min) && valid;
+        const simd_mask is_max = (batch >= val_max) && valid;
+        val_min = select(is_min, batch, val_min);
+        idx_min = select(is_min, idx_simd, idx_min);
+        val_max = select(is_max, batch, val_max);
+        idx_max = select(is_max, idx_simd, idx_max);
+    }
+
+    __KFP_SIMD__SPEC_ALIGN(simd_type::SimdSize) T data_min[SimdLen]{}; // Helper data array
+    __KFP_SIMD__SPEC_ALIGN(simd_type::SimdSize) T data_max[SimdLen]{}; // Helper data array
+    __KFP_SIMD__SPEC_ALIGN(simd_int::SimdSize) int index_min[SimdLen]{}; // Helper data array
+    __KFP_SIMD__SPEC_ALIGN(simd_int::SimdSize) int index_max[SimdLen]{}; // Helper data array
+    val_min.store_a(data_min);
+    val_max.store_a(data_max);
+    idx_min.store_a(index_min);
+    idx_max.store_a(index_max);
+    int lane_min = 0;
+    int lane_max = 0;
+    for (int iLane = 1; iLane < simd_type::SimdLen; ++iLane) {
+        if ((data_min[iLane] < data_min[lane_min]) ||
+            (data_min[iLane] == data_min[lane_min] && index_min[iLane] < index_min[lane_min])) {
+            lane_min = iLane;
+        }
+        if ((data_max[iLane] > data_max[lane_max]) ||
+            (data_max[iLane] == data_max[lane_max] && index_max[iLane] > index_max[lane_max])) {
+            lane_max = iLane;
+        }
+    }
+    return { static_cast<std::size_t>(index_min[lane_min]),
+             static_cast<std::size_t>(index_max[lane_max]) };
+}
+
+template <bool Aligned, typename T>
+inline void fillImpl(T* out, std::size_t size, T value)
+{
+    constexpr std::size_t SimdLen = SimdOf<T>::SimdLen;
+    const SimdOf<T> val_simd{ value };
+    std::size_t idx = 0;
+    for (; idx + SimdLen <= size; idx += SimdLen) {
+        BatchAccess<Aligned>::store(val_simd, out + idx);
+    }
+    if (idx < size) {
+        val_simd.store_partial(static_cast<int>(size - idx), out + idx);
+    }
+}
+
+template <bool Aligned, typename T, typename Predicate>
+inline std::size_t copyIfImpl(const T* in, std::size_t size, T* out, const Predicate& pred)
+{
+    using simd_type = SimdOf<T>;
+    constexpr std::size_t SimdLen = simd_type::SimdLen;
+    std::size_t count = 0;
+    auto compress = [&](const simd_type& batch, const simd_mask& mask) {
+        __KFP_SIMD__SPEC_ALIGN(simd_type::SimdSize) T data[SimdLen]{}; // Helper data array
+        batch.store_a(data);
+        for (int iLane = 0; iLane < simd_type::SimdLen; ++iLane) {
+            if (mask[iLane]) {
+                out[count++] = data[iLane];
+            }
+        }
+    };
+    std::size_t idx = 0;
+    for (; idx + SimdLen <= size; idx += SimdLen) {
+        const simd_type batch = BatchAccess<Aligned>::load(in + idx);
+        const simd_mask mask{ pred(batch) };
+        // Whole batches are stored at once, mixed ones lane by lane
+        if (mask.AND()) {
+            batch.store(out + count);
+            count += SimdLen;
+        } else if (mask.OR()) {
+            compress(batch, mask);
+        }
+    }
+    if (idx < size) {
+        const int n = static_cast<int>(size - idx);
+        const simd_type batch = simd_type{}.load_partial(n, in + idx);
+        const simd_mask mask = simd_mask{ pred(batch) } && laneMask(n);
+        if (mask.OR()) {
+            compress(batch, mask);
+        }
+    }
+    return count;
+}
+
+} // namespace Detail
+
+// ------------------------------------------------------
+// transform
+// ------------------------------------------------------
+// out[i] = func(in[i]) for i in [0, size). func is called on whole batches
+// when it accepts simd_float/simd_int (see apply), otherwise once per lane.
+// in and out may be the same range.
+template <typename T, typename F>
+inline void transform(const T* in, T* out, std::size_t size, const F& func)
+{
+    if (Detail::isSimdAligned(in) && Detail::isSimdAligned(out)) {
+        Detail::transformImpl<true>(in, out, size, func);
+    } else {
+        Detail::transformImpl<false>(in, out, size, func);
+    }
+}
+
+// Resizes out to the size of in.
+template <typename T, std::size_t AlignmentIn, std::size_t AlignmentOut, typename F>
+inline void transform(const Vector<T, AlignmentIn>& in, Vector<T, AlignmentOut>& out,
+                      const F& func)
+{
+    out.resize(in.size());
+    if constexpr (Detail::isSimdAlignedVector<T, AlignmentIn>() &&
+                  Detail::isSimdAlignedVector<T, AlignmentOut>()) {
+        Detail::transformImpl<true>(in.data(), out.data(), in.size(), func);
+    } else {
+        transform(in.data(), out.data(), in.size(), func);
+    }
+}
+
+// ------------------------------------------------------
+// reduce and transform_reduce
+// ------------------------------------------------------
+// Combines init with reduce_op(transform_op(in[i])) for i in [0, size).
+// reduce_op must be associative and commutative: the elements are combined
+// in SimdLen * 4 interleaved chains, so float sums differ from a sequential
+// loop in rounding.
+template <typename T, typename BinaryOp, typename UnaryOp>
+inline T transform_reduce(const T* in, std::size_t size, T init, const BinaryOp& reduce_op,
+                          const UnaryOp& transform_op)
+{
+    if (Detail::isSimdAligned(in)) {
+        return Detail::transformReduceImpl<true>(in, size, init, reduce_op, transform_op);
+    }
+    return Detail::transformReduceImpl<false>(in, size, init, reduce_op, transform_op);
+}
+template <typename T, std::size_t Alignment, typename BinaryOp, typename UnaryOp>
+inline T transform_reduce(const Vector<T, Alignment>& in, T init, const BinaryOp& reduce_op,
+                          const UnaryOp& transform_op)
+{
+    if constexpr (Detail::isSimdAlignedVector<T, Alignment>()) {
+        return Detail::transformReduceImpl<true>(in.data(), in.size(), init, reduce_op,
+                                                 transform_op);
+    } else {
+        return transform_reduce(in.data(), in.size(), init, reduce_op, transform_op);
+    }
+}
+
+template <typename T, typename BinaryOp = Detail::Plus>
+inline T reduce(const T* in, std::size_t size, T init = T{ 0 },
+                const BinaryOp& reduce_op = BinaryOp{})
+{
+    return transform_reduce(in, size, init, reduce_op, Detail::Identity{});
+}
+template <typename T, std::size_t Alignment, typename BinaryOp = Detail::Plus>
+inline T reduce(const Vector<T, Alignment>& in, T init = T{ 0 },
+                const BinaryOp& reduce_op = BinaryOp{})
+{
+    return transform_reduce(in, init, reduce_op, Detail::Identity{});
+}
+
+// ------------------------------------------------------
+// count_if and find_if
+// ------------------------------------------------------
+// Number of elements for which pred (returning simd_mask) is true.
+template <typename T, typename Predicate>
+inline std::size_t count_if(const T* in, std::size_t size, const Predicate& pred)
+{
+    if (Detail::isSimdAligned(in)) {
+        return Detail::countIfImpl<true>(in, size, pred);
+    }
+    return Detail::countIfImpl<false>(in, size, pred);
+}
+template <typename T, std::size_t Alignment, typename Predicate>
+inline std::size_t count_if(const Vector<T, Alignment>& in, const Predicate& pred)
+{
+    if constexpr (Detail::isSimdAlignedVector<T, Alignment>()) {
+        return Detail::countIfImpl<true>(in.data(), in.size(), pred);
+    } else {
+        return count_if(in.data(), in.size(), pred);
+    }
+}
+
+// Index of the first element for which pred is true, size if there is none.
+template <typename T, typename Predicate>
+inline std::size_t find_if(const T* in, std::size_t size, const Predicate& pred)
+{
+    if (Detail::isSimdAligned(in)) {
+        return Detail::findIfImpl<true>(in, size, pred);
+    }
+    return Detail::findIfImpl<false>(in, size, pred);
+}
+template <typename T, std::size_t Alignment, typename Predicate>
+inline std::size_t find_if(const Vector<T, Alignment>& in, const Predicate& pred)
+{
+    if constexpr (Detail::isSimdAlignedVector<T, Alignment>()) {
+        return Detail::findIfImpl<true>(in.data(), in.size(), pred);
+    } else {
+        return find_if(in.data(), in.size(), pred);
+    }
+}
+
+// ------------------------------------------------------
+// minmax_element
+// ------------------------------------------------------
+// Indices of the first smallest and the last largest element, as
+// std::minmax_element. {size, size} for an empty range.
+template <typename T>
+inline std::pair<std::size_t, std::size_t> minmax_element(const T* in, std::size_t size)
+{
+    if (Detail::isSimdAligned(in)) {
+        return Detail::minmaxElementImpl<true>(in, size);
+    }
+    return Detail::minmaxElementImpl<false>(in, size);
+}
+template <typename T, std::size_t Alignment>
+inline std::pair<std::size_t, std::size_t> minmax_element(const Vector<T, Alignment>& in)
+{
+    if constexpr (Detail::isSimdAlignedVector<T, Alignment>()) {
+        return Detail::minmaxElementImpl<true>(in.data(), in.size());
+    } else {
+        return minmax_element(in.data(), in.size());
+    }
+}
+
+// ------------------------------------------------------
+// fill and copy_if
+// ------------------------------------------------------
+template <typename T> inline void fill(T* out, std::size_t size, T value)
+{
+    if (Detail::isSimdAligned(out)) {
+        Detail::fillImpl<true>(out, size, value);
+    } else {
+        Detail::fillImpl<false>(out, size, value);
+    }
+}
+template <typename T, std::size_t Alignment>
+inline void fill(Vector<T, Alignment>& out, T value)
+{
+    if constexpr (Detail::isSimdAlignedVector<T, Alignment>()) {
+        Detail::fillImpl<true>(out.data(), out.size(), value);
+    } else {
+        fill(out.data(), out.size(), value);
+    }
+}
+
+// Copies the elements for which pred is true to out, keeping their order, and
+// returns their number. out needs room for size elements and may equal in.
+template <typename T, typename Predicate>
+inline std::size_t copy_if(const T* in, std::size_t size, T* out, const Predicate& pred)
+{
+    if (Detail::isSimdAligned(in)) {
+        return Detail::copyIfImpl<true>(in, size, out, pred);
+    }
+    return Detail::copyIfImpl<false>(in, size, out, pred);
+}
+// Resizes out to the number of copied elements.
+template <typename T, std::size_t AlignmentIn, std::size_t AlignmentOut, typename Predicate>
+inline void copy_if(const Vector<T, AlignmentIn>& in, Vector<T, AlignmentOut>& out,
+                    const Predicate& pred)
+{
+    const std::size_t size = in.size();
+    if (static_cast<const void*>(&in) != static_cast<const void*>(&out)) {
+        out.resize(size);
+    }
+    std::size_t count{ 0 };
+    if constexpr (Detail::isSimdAlignedVector<T, AlignmentIn>()) {
+        count = Detail::copyIfImpl<true>(in.data(), size, out.data(), pred);
+    } else {
+        count = copy_if(in.data(), size, out.data(), pred);
+    }
+    out.resize(count);
+}
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_ALGORITHM_H
@@ -14,8 +14,14 @@ Emails: mithran@fias.uni-frankfurt.de
 #include <cstddef>
 #include <limits>
 #include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
+#if defined(__x86_64__) || defined(__i386__)
 #include <mm_malloc.h>
+#else
+#include <cstdlib>
+#endif
 
 namespace KFP
 {
@@ -36,7 +42,17 @@ template<std::size_t alignment>
 inline void* alignedAllocate(std::size_t size)
 {
     static_assert(alignment && isAlignment(alignment), "[Error] (KFP::SIMD::alignedAllocate): Invalid value given for aligment");
+#if defined(__x86_64__) || defined(__i386__)
     return _mm_malloc(size, alignment);
+#else
+    // Scalar builds on other platforms: posix_memalign needs at least pointer alignment
+    constexpr std::size_t align_val = (alignment < sizeof(void*)) ? sizeof(void*) : alignment;
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, align_val, size) != 0) {
+        return nullptr;
+    }
+    return ptr;
+#endif
     // if(!size) return nullptr;
 
     // constexpr std::size_t voidptr_Alignment = alignof(void*);
@@ -67,7 +83,11 @@ inline void* alignedAllocate(std::size_t size)
 
 inline void alignedDeallocate(void* ptr)
 {
+#if defined(__x86_64__) || defined(__i386__)
     _mm_free(ptr);
+#else
+    std::free(ptr);
+#endif
     // if (ptr) {
     //     ::operator delete(*(static_cast<void**>(ptr) - 1));
     // }
@@ -110,7 +130,26 @@ inline void alignedDeallocate(void* ptr)
     }                                                                                                                   \
 
 
-template<typename T, std::size_t Alignment>
+// Default page policy of AlignedAllocator: alignedAllocate on the heap. A
+// policy provides allocate<Alignment>(bytes), returning non-null or throwing,
+// and deallocate(ptr, bytes); see HugePages in simd_hugepage.h.
+struct DefaultPages {
+    template<std::size_t Alignment>
+    static void* allocate(std::size_t size)
+    {
+        void* p = alignedAllocate<Alignment>(size);
+        if (!p) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+    static void deallocate(void* ptr, std::size_t /* size */) noexcept
+    {
+        alignedDeallocate(ptr);
+    }
+};
+
+template<typename T, std::size_t Alignment, typename Pages = DefaultPages>
 class AlignedAllocator {
     static_assert(isAlignment(Alignment), "[Error] (AlignedAllocator): Invalid value given for aligment");
     static_assert(
@@ -130,13 +169,13 @@ public:
 
     template<typename U>
     struct rebind {
-        typedef AlignedAllocator<U, Alignment> other;
+        typedef AlignedAllocator<U, Alignment, Pages> other;
     };
 
     AlignedAllocator() noexcept
     {}
     template <typename U>
-    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+    AlignedAllocator(const AlignedAllocator<U, Alignment, Pages>&) noexcept
     {}
 
     pointer address(reference x) const noexcept
@@ -150,16 +189,12 @@ public:
         if (size == 0) {
             return nullptr;
         }
-        void* p = alignedAllocate<Alignment>(sizeof(T) * size);
-        if (!p) {
-            throw std::bad_alloc();
-        }
-        return static_cast<pointer>(p);
+        return static_cast<pointer>(Pages::template allocate<Alignment>(sizeof(T) * size));
     }
 
-    void deallocate(pointer ptr, size_type) noexcept
+    void deallocate(pointer ptr, size_type size) noexcept
     {
-        alignedDeallocate(static_cast<void*>(ptr));
+        Pages::deallocate(static_cast<void*>(ptr), sizeof(T) * size);
     }
 
     size_type max_size() const noexcept
@@ -183,25 +218,58 @@ public:
     }
 };
 
-template<typename T, typename U, std::size_t Alignment>
+template<typename T, typename U, std::size_t Alignment, typename Pages>
 inline bool
-operator==(const AlignedAllocator<T, Alignment>&,
-    const AlignedAllocator<U, Alignment>&) noexcept
+operator==(const AlignedAllocator<T, Alignment, Pages>&,
+    const AlignedAllocator<U, Alignment, Pages>&) noexcept
 {
     return true;
 }
 
-template<typename T, typename U, std::size_t Alignment>
+template<typename T, typename U, std::size_t Alignment, typename Pages>
 inline bool
-operator!=(const AlignedAllocator<T, Alignment>&,
-    const AlignedAllocator<U, Alignment>&) noexcept
+operator!=(const AlignedAllocator<T, Alignment, Pages>&,
+    const AlignedAllocator<U, Alignment, Pages>&) noexcept
 {
     return false;
 }
 
+// AlignedAllocator that default-initializes instead of value-initializing:
+// resize(n) on a vector of float or int leaves the new elements
+// uninitialized instead of zeroing them. Types with a constructor are still
+// constructed as usual.
+template<typename T, std::size_t Alignment, typename Pages = DefaultPages>
+class DefaultInitAllocator : public AlignedAllocator<T, Alignment, Pages> {
+public:
+    template<typename U>
+    struct rebind {
+        typedef DefaultInitAllocator<U, Alignment, Pages> other;
+    };
+
+    DefaultInitAllocator() noexcept
+    {}
+    template <typename U>
+    DefaultInitAllocator(const DefaultInitAllocator<U, Alignment, Pages>&) noexcept
+    {}
+
+    template<typename U, typename... Args>
+    void construct(U* ptr, Args&&... args) {
+        ::new(static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+    }
+
+    template<typename U>
+    void construct(U* ptr) noexcept(std::is_nothrow_default_constructible<U>::value) {
+        ::new(static_cast<void*>(ptr)) U;
+    }
+};
+
 template<typename T, std::size_t Alignment = alignof(T)>
 using Vector = std::vector<T, AlignedAllocator<T, Alignment>>;
 
+// Vector whose resize() does not zero trivial elements
+template<typename T, std::size_t Alignment = alignof(T)>
+using DefaultInitVector = std::vector<T, DefaultInitAllocator<T, Alignment>>;
+
 } // namespace SIMD
 } // namespace KFP
 
@@ -0,0 +1,275 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_AOSOA_H
+#define SIMD_AOSOA_H
+
+#include "simd_algorithm.h"
+#include "simd_allocate.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+// Array of SIMD blocks: block b holds the records [b * SimdLen, (b + 1) *
+// SimdLen) field by field, every field one aligned batch. A kernel that needs
+// all fields of a record walks one contiguous block instead of one stream per
+// field (SoA), and still loads whole batches (unlike AoS). Records past size()
+// are kept zero. Included by simd.h once the backend types are defined.
+
+namespace KFP {
+namespace SIMD {
+
+template <typename... Fields> class AoSoA
+{
+    static_assert(sizeof...(Fields) > 0, "[Error] (KFP::SIMD::AoSoA): No fields given.");
+    static_assert(((std::is_same<Fields, float>::value || std::is_same<Fields, int>::value) && ...),
+                  "[Error] (KFP::SIMD::AoSoA): Fields must be float or int.");
+
+public:
+    static constexpr int NFields{ sizeof...(Fields) };
+    static constexpr int SimdLen{ simd_float::SimdLen };
+    static constexpr std::size_t Alignment{ simd_float::SimdSize };
+    template <std::size_t K> using field_type = typename std::tuple_element<K, std::tuple<Fields...>>::type;
+    template <std::size_t K> using simd_type = Detail::SimdOf<field_type<K>>;
+
+    // SimdLen records, field K in bytes [offset(K), offset(K) + SimdSize)
+    class Block
+    {
+    public:
+        Block()
+        {
+            std::memset(data_, 0, sizeof(data_));
+        }
+
+        template <std::size_t K> field_type<K>* data()
+        {
+            return reinterpret_cast<field_type<K>*>(data_ + offset<K>());
+        }
+        template <std::size_t K> const field_type<K>* data() const
+        {
+            return reinterpret_cast<const field_type<K>*>(data_ + offset<K>());
+        }
+        // Field K of record iLane in the block
+        template <std::size_t K> field_type<K>& get(int iLane)
+        {
+            return data<K>()[iLane];
+        }
+        template <std::size_t K> const field_type<K>& get(int iLane) const
+        {
+            return data<K>()[iLane];
+        }
+
+        template <std::size_t K> simd_type<K> load() const
+        {
+            return simd_type<K>{}.load_a(data<K>());
+        }
+        template <std::size_t K> void store(const simd_type<K>& val_simd)
+        {
+            val_simd.store_a(data<K>());
+        }
+        // Only the lanes selected by mask are written
+        template <std::size_t K> void store(const simd_type<K>& val_simd, const simd_mask& mask)
+        {
+            select(mask, val_simd, load<K>()).store_a(data<K>());
+        }
+
+        template <std::size_t K> static constexpr std::size_t offset()
+        {
+            constexpr std::size_t sizes[sizeof...(Fields)]{ sizeof(Fields)... };
+            std::size_t bytes = 0;
+            for (std::size_t k = 0; k < K; ++k) {
+                bytes += sizes[k] * SimdLen;
+            }
+            return bytes;
+        }
+
+    private:
+        alignas(Alignment) char data_[(sizeof(Fields) + ...) * SimdLen];
+    };
+    static_assert(sizeof(Block) % Alignment == 0, "[Error] (KFP::SIMD::AoSoA): Block size breaks alignment.");
+
+    typedef Vector<Block, Alignment> block_vector;
+    typedef typename block_vector::iterator iterator;
+    typedef typename block_vector::const_iterator const_iterator;
+
+    AoSoA() = default;
+    explicit AoSoA(std::size_t size)
+    {
+        resize(size);
+    }
+
+    // ------------------------------------------------------
+    // Size and capacity
+    // ------------------------------------------------------
+    std::size_t size() const
+    {
+        return size_;
+    }
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+    std::size_t block_count() const
+    {
+        return blocks_.size();
+    }
+    // Lanes of block b holding records
+    simd_mask block_mask(std::size_t b) const
+    {
+        const std::size_t begin = b * SimdLen;
+        return Detail::laneMask((size_ > begin) ? static_cast<int>(std::min<std::size_t>(size_ - begin, SimdLen)) : 0);
+    }
+
+    void reserve(std::size_t size)
+    {
+        blocks_.reserve(blockCount(size));
+    }
+    // New records are zero
+    void resize(std::size_t size)
+    {
+        if (size < size_) {
+            clearRange(size, std::min(size_, blockCount(size) * SimdLen));
+        }
+        blocks_.resize(blockCount(size));
+        size_ = size;
+    }
+    void clear()
+    {
+        blocks_.clear();
+        size_ = 0;
+    }
+    void push_back(Fields... values)
+    {
+        if (size_ == blocks_.size() * SimdLen) {
+            blocks_.emplace_back();
+        }
+        setRecord(size_, std::index_sequence_for<Fields...>{}, values...);
+        ++size_;
+    }
+
+    // ------------------------------------------------------
+    // Access
+    // ------------------------------------------------------
+    template <std::size_t K> field_type<K>& get(std::size_t i)
+    {
+        return blocks_[i / SimdLen].template get<K>(i % SimdLen);
+    }
+    template <std::size_t K> const field_type<K>& get(std::size_t i) const
+    {
+        return blocks_[i / SimdLen].template get<K>(i % SimdLen);
+    }
+    Block& block(std::size_t b)
+    {
+        return blocks_[b];
+    }
+    const Block& block(std::size_t b) const
+    {
+        return blocks_[b];
+    }
+    iterator begin()
+    {
+        return blocks_.begin();
+    }
+    iterator end()
+    {
+        return blocks_.end();
+    }
+    const_iterator begin() const
+    {
+        return blocks_.begin();
+    }
+    const_iterator end() const
+    {
+        return blocks_.end();
+    }
+
+    // ------------------------------------------------------
+    // Conversion from and to AoS
+    // ------------------------------------------------------
+    // Record is a plain struct with the fields in the same order and no
+    // padding, e.g. struct { float x, y, z; int charge; }
+    template <typename Record> void fromAoS(const Record* records, std::size_t n)
+    {
+        checkRecord<Record>();
+        resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const char* record = reinterpret_cast<const char*>(records + i);
+            Block& target = blocks_[i / SimdLen];
+            const int iLane = static_cast<int>(i % SimdLen);
+            forEachField([&](auto k) {
+                std::memcpy(&target.template get<k>(iLane), record + recordOffset<k>(), sizeof(field_type<k>));
+            });
+        }
+    }
+    template <typename Record> void toAoS(Record* records) const
+    {
+        checkRecord<Record>();
+        for (std::size_t i = 0; i < size_; ++i) {
+            char* record = reinterpret_cast<char*>(records + i);
+            const Block& source = blocks_[i / SimdLen];
+            const int iLane = static_cast<int>(i % SimdLen);
+            forEachField([&](auto k) {
+                std::memcpy(record + recordOffset<k>(), &source.template get<k>(iLane), sizeof(field_type<k>));
+            });
+        }
+    }
+
+private:
+    static std::size_t blockCount(std::size_t size)
+    {
+        return (size + SimdLen - 1) / SimdLen;
+    }
+    // Bytes in front of field K in a record
+    template <std::size_t K> static constexpr std::size_t recordOffset()
+    {
+        return Block::template offset<K>() / SimdLen;
+    }
+    template <typename Record> static void checkRecord()
+    {
+        static_assert(std::is_trivially_copyable<Record>::value && sizeof(Record) == (sizeof(Fields) + ...),
+                      "[Error] (KFP::SIMD::AoSoA): Record must be a trivially copyable struct of the fields without padding.");
+    }
+    // func(std::integral_constant<std::size_t, K>) for every field K
+    template <typename F> static void forEachField(F&& func)
+    {
+        forEachFieldImpl(func, std::index_sequence_for<Fields...>{});
+    }
+    template <typename F, std::size_t... K> static void forEachFieldImpl(F& func, std::index_sequence<K...>)
+    {
+        (func(std::integral_constant<std::size_t, K>{}), ...);
+    }
+
+    template <std::size_t... K> void setRecord(std::size_t i, std::index_sequence<K...>, Fields... values)
+    {
+        Block& target = blocks_[i / SimdLen];
+        const int iLane = static_cast<int>(i % SimdLen);
+        ((target.template get<K>(iLane) = values), ...);
+    }
+    // Zeroes records [begin, end), all within allocated blocks
+    void clearRange(std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i) {
+            Block& target = blocks_[i / SimdLen];
+            const int iLane = static_cast<int>(i % SimdLen);
+            forEachField([&](auto k) { target.template get<k>(iLane) = field_type<k>{ 0 }; });
+        }
+    }
+
+    block_vector blocks_{};
+    std::size_t size_{ 0 };
+};
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_AOSOA_H
@@ -0,0 +1,267 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_ARENA_H
+#define SIMD_ARENA_H
+
+#include "simd_allocate.h"
+#include "simd_macros.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Monotonic arena for per-event scratch memory. Memory is taken from large
+// aligned chunks by bumping an offset and is only given back all at once:
+// reset() between events, or rewind() to a marker at the end of a sub-phase.
+// Chunks are kept across resets, so after the first events no allocation
+// reaches alignedAllocate. Not thread safe: use one arena per thread.
+
+namespace KFP {
+namespace SIMD {
+
+class SimdArena
+{
+public:
+    // Alignment of every chunk, enough for any simd type and a cache line
+    static constexpr std::size_t ChunkAlignment{ (__KFP_SIMD__Size_Float > 64) ? __KFP_SIMD__Size_Float : 64 };
+
+    // Position in the arena, see mark() and rewind()
+    struct Marker
+    {
+        std::size_t chunk;
+        std::size_t offset;
+    };
+
+    explicit SimdArena(std::size_t chunkSize = std::size_t{ 1 } << 20) : chunks_{}, chunkSize_{ chunkSize } {}
+    SimdArena(const SimdArena&) = delete;
+    SimdArena& operator=(const SimdArena&) = delete;
+    ~SimdArena()
+    {
+        release();
+    }
+
+    // ------------------------------------------------------
+    // Allocation
+    // ------------------------------------------------------
+    void* allocate(std::size_t size, std::size_t alignment = ChunkAlignment)
+    {
+        assert((isAlignment(alignment) && alignment <= ChunkAlignment) &&
+               (std::string{ "[Error] (KFP::SIMD::SimdArena::allocate): Invalid alignment, given: " } +
+                std::to_string(alignment))
+                   .data());
+        if (current_ < chunks_.size()) {
+            const std::size_t offset = alignUp(offset_, alignment);
+            if (offset + size <= chunks_[current_].size) {
+                offset_ = offset + size;
+                last_ = chunks_[current_].data + offset;
+                return last_;
+            }
+        }
+        return allocateSlow(size);
+    }
+    // Gives the memory back only if it is the latest allocation, as when a
+    // vector grows; everything else waits for reset() or rewind()
+    void deallocate(void* ptr, std::size_t size) noexcept
+    {
+        if (ptr != nullptr && ptr == last_ && last_ + size == chunks_[current_].data + offset_) {
+            offset_ = static_cast<std::size_t>(last_ - chunks_[current_].data);
+            last_ = nullptr;
+        }
+    }
+
+    // ------------------------------------------------------
+    // Reset and markers
+    // ------------------------------------------------------
+    // Frees everything allocated, the chunks are kept for reuse
+    void reset() noexcept
+    {
+        current_ = 0;
+        offset_ = 0;
+        last_ = nullptr;
+    }
+    Marker mark() const noexcept
+    {
+        return Marker{ current_, offset_ };
+    }
+    // Frees everything allocated after marker m
+    void rewind(const Marker& m) noexcept
+    {
+        current_ = m.chunk;
+        offset_ = m.offset;
+        last_ = nullptr;
+    }
+    // Returns all chunks to the system
+    void release() noexcept
+    {
+        for (const Chunk& chunk : chunks_) {
+            alignedDeallocate(chunk.data);
+        }
+        chunks_.clear();
+        reset();
+    }
+
+    // ------------------------------------------------------
+    // Statistics
+    // ------------------------------------------------------
+    // Bytes handed out since the last reset, including alignment gaps
+    std::size_t used() const noexcept
+    {
+        std::size_t bytes = offset_;
+        for (std::size_t iChunk = 0; iChunk < current_ && iChunk < chunks_.size(); ++iChunk) {
+            bytes += chunks_[iChunk].size;
+        }
+        return bytes;
+    }
+    std::size_t capacity() const noexcept
+    {
+        std::size_t bytes = 0;
+        for (const Chunk& chunk : chunks_) {
+            bytes += chunk.size;
+        }
+        return bytes;
+    }
+    std::size_t chunkCount() const noexcept
+    {
+        return chunks_.size();
+    }
+
+private:
+    struct Chunk
+    {
+        char* data;
+        std::size_t size;
+    };
+
+    static std::size_t alignUp(std::size_t offset, std::size_t alignment)
+    {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Moves on to the next chunk that fits, allocating one if needed. Chunks
+    // too small for the request are skipped until the next reset. Chunks
+    // start at ChunkAlignment, so any alignment holds at offset 0.
+    void* allocateSlow(std::size_t size)
+    {
+        std::size_t next = (current_ < chunks_.size()) ? current_ + 1 : current_;
+        while (next < chunks_.size() && chunks_[next].size < size) {
+            ++next;
+        }
+        if (next == chunks_.size()) {
+            const std::size_t chunkSize = (size > chunkSize_) ? alignUp(size, ChunkAlignment) : chunkSize_;
+            char* data = static_cast<char*>(alignedAllocate<ChunkAlignment>(chunkSize));
+            if (!data) {
+                throw std::bad_alloc();
+            }
+            chunks_.push_back(Chunk{ data, chunkSize });
+        }
+        current_ = next;
+        offset_ = size;
+        last_ = chunks_[current_].data;
+        return last_;
+    }
+
+    std::vector<Chunk> chunks_;
+    std::size_t chunkSize_;
+    std::size_t current_{ 0 };
+    std::size_t offset_{ 0 };
+    char* last_{ nullptr };
+};
+
+// Rewinds the arena to its state at construction when going out of scope
+class SimdArenaScope
+{
+public:
+    explicit SimdArenaScope(SimdArena& arena) : arena_{ arena }, marker_{ arena.mark() } {}
+    SimdArenaScope(const SimdArenaScope&) = delete;
+    SimdArenaScope& operator=(const SimdArenaScope&) = delete;
+    ~SimdArenaScope()
+    {
+        arena_.rewind(marker_);
+    }
+
+private:
+    SimdArena& arena_;
+    SimdArena::Marker marker_;
+};
+
+// ------------------------------------------------------
+// Allocator
+// ------------------------------------------------------
+// Standard allocator on a SimdArena, for std::vector and ArenaVector. The
+// memory of a container is invalid after the arena is reset or rewound past
+// it, so containers must not outlive the event (or scope) they belong to.
+template <typename T, std::size_t Alignment = __KFP_SIMD__Size_Float> class ArenaAllocator
+{
+    static_assert(isAlignment(Alignment) && Alignment <= SimdArena::ChunkAlignment,
+                  "[Error] (KFP::SIMD::ArenaAllocator): Invalid value given for alignment");
+    static_assert(Alignment >= alignof(T),
+                  "[Error] (KFP::SIMD::ArenaAllocator): Alignment below the alignment of the type.");
+
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    template <typename U> struct rebind
+    {
+        typedef ArenaAllocator<U, Alignment> other;
+    };
+
+    explicit ArenaAllocator(SimdArena& arena) noexcept : arena_{ &arena } {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U, Alignment>& other) noexcept : arena_{ other.arena() }
+    {
+    }
+
+    pointer allocate(size_type size)
+    {
+        return static_cast<pointer>(arena_->allocate(sizeof(T) * size, Alignment));
+    }
+    void deallocate(pointer ptr, size_type size) noexcept
+    {
+        arena_->deallocate(ptr, sizeof(T) * size);
+    }
+
+    SimdArena* arena() const noexcept
+    {
+        return arena_;
+    }
+
+private:
+    SimdArena* arena_;
+};
+
+template <typename T, typename U, std::size_t Alignment>
+inline bool operator==(const ArenaAllocator<T, Alignment>& a, const ArenaAllocator<U, Alignment>& b) noexcept
+{
+    return a.arena() == b.arena();
+}
+template <typename T, typename U, std::size_t Alignment>
+inline bool operator!=(const ArenaAllocator<T, Alignment>& a, const ArenaAllocator<U, Alignment>& b) noexcept
+{
+    return a.arena() != b.arena();
+}
+
+// Vector with arena storage: ArenaVector<float> v{ ArenaAllocator<float>{ arena } };
+template <typename T, std::size_t Alignment = __KFP_SIMD__Size_Float>
+using ArenaVector = std::vector<T, ArenaAllocator<T, Alignment>>;
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_ARENA_H
@@ -0,0 +1,225 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_BUFFER_H
+#define SIMD_BUFFER_H
+
+#include "simd_allocate.h"
+#include "simd_hugepage.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// Aligned growable array of a trivially copyable type for large per-event
+// buffers. Unlike Vector, new elements are not initialized unless a value is
+// given, and growth goes through hugePageReallocate: a buffer that reached
+// HugePageThreshold lives in its own mapping and grows with mremap, without
+// allocate + copy + free.
+
+namespace KFP {
+namespace SIMD {
+
+template <typename T, std::size_t Alignment = alignof(T)> class Buffer
+{
+    static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value,
+                  "[Error] (KFP::SIMD::Buffer): Type must be trivially copyable.");
+    static_assert(isAlignment(Alignment) && Alignment >= alignof(T),
+                  "[Error] (KFP::SIMD::Buffer): Invalid value given for alignment");
+
+public:
+    typedef T value_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    Buffer() = default;
+    explicit Buffer(std::size_t size)
+    {
+        resize(size);
+    }
+    Buffer(std::size_t size, const T& value)
+    {
+        resize(size, value);
+    }
+    Buffer(const Buffer& other)
+    {
+        *this = other;
+    }
+    Buffer(Buffer&& other) noexcept
+    {
+        swap(other);
+    }
+    Buffer& operator=(const Buffer& other)
+    {
+        if (this != &other) {
+            size_ = 0;
+            reserve(other.size_);
+            std::copy(other.data_, other.data_ + other.size_, data_);
+            size_ = other.size_;
+        }
+        return *this;
+    }
+    Buffer& operator=(Buffer&& other) noexcept
+    {
+        Buffer{ std::move(other) }.swap(*this);
+        return *this;
+    }
+    ~Buffer()
+    {
+        hugePageDeallocate(data_);
+    }
+    void swap(Buffer& other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    // ------------------------------------------------------
+    // Size and capacity
+    // ------------------------------------------------------
+    std::size_t size() const
+    {
+        return size_;
+    }
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+    std::size_t capacity() const
+    {
+        return capacity_;
+    }
+    // Backing of the current storage, see simd_hugepage.h
+    PageBacking backing() const
+    {
+        return pageBacking(data_);
+    }
+
+    void reserve(std::size_t capacity)
+    {
+        if (capacity > capacity_) {
+            reallocate(capacity);
+        }
+    }
+    // New elements are left uninitialized
+    void resize(std::size_t size)
+    {
+        if (size > capacity_) {
+            reallocate(std::max(size, 2 * capacity_));
+        }
+        size_ = size;
+    }
+    void resize(std::size_t size, const T& value)
+    {
+        const std::size_t oldSize = size_;
+        resize(size);
+        if (size > oldSize) {
+            std::fill(data_ + oldSize, data_ + size, value);
+        }
+    }
+    void clear()
+    {
+        size_ = 0;
+    }
+    void push_back(const T& value)
+    {
+        if (size_ == capacity_) {
+            // value may live in the buffer
+            const T copy = value;
+            reallocate(std::max<std::size_t>(2 * capacity_, 16));
+            data_[size_++] = copy;
+            return;
+        }
+        data_[size_++] = value;
+    }
+    void pop_back()
+    {
+        --size_;
+    }
+
+    // ------------------------------------------------------
+    // Element access
+    // ------------------------------------------------------
+    T* data()
+    {
+        return data_;
+    }
+    const T* data() const
+    {
+        return data_;
+    }
+    T& operator[](std::size_t i)
+    {
+        return data_[i];
+    }
+    const T& operator[](std::size_t i) const
+    {
+        return data_[i];
+    }
+    T& front()
+    {
+        return data_[0];
+    }
+    const T& front() const
+    {
+        return data_[0];
+    }
+    T& back()
+    {
+        return data_[size_ - 1];
+    }
+    const T& back() const
+    {
+        return data_[size_ - 1];
+    }
+    iterator begin()
+    {
+        return data_;
+    }
+    iterator end()
+    {
+        return data_ + size_;
+    }
+    const_iterator begin() const
+    {
+        return data_;
+    }
+    const_iterator end() const
+    {
+        return data_ + size_;
+    }
+
+private:
+    void reallocate(std::size_t capacity)
+    {
+        assert((capacity >= size_) &&
+               (std::string{ "[Error] (KFP::SIMD::Buffer::reallocate): Capacity below size, given: " } +
+                std::to_string(capacity))
+                   .data());
+        void* grown = hugePageReallocate<Alignment>(data_, size_ * sizeof(T), capacity * sizeof(T));
+        if (!grown) {
+            throw std::bad_alloc();
+        }
+        data_ = static_cast<T*>(grown);
+        capacity_ = capacity;
+    }
+
+    T* data_{ nullptr };
+    std::size_t size_{ 0 };
+    std::size_t capacity_{ 0 };
+};
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_BUFFER_H
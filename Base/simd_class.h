@@ -222,6 +222,37 @@ public:
         return a;
     }
 
+    // Fused multiply-add: a*b+c, a*b-c, -(a*b)+c and -(a*b)-c with a single
+    // rounding when the target has FMA, otherwise a multiply and an add.
+    friend SimdClassBase fmadd(const SimdClassBase& a, const SimdClassBase& b,
+                               const SimdClassBase& c)
+    {
+        return SimdClassBase{ Detail::fmadd<simd_type>(a.data_.simd_,
+                                                       b.data_.simd_,
+                                                       c.data_.simd_) };
+    }
+    friend SimdClassBase fmsub(const SimdClassBase& a, const SimdClassBase& b,
+                               const SimdClassBase& c)
+    {
+        return SimdClassBase{ Detail::fmsub<simd_type>(a.data_.simd_,
+                                                       b.data_.simd_,
+                                                       c.data_.simd_) };
+    }
+    friend SimdClassBase fnmadd(const SimdClassBase& a, const SimdClassBase& b,
+                                const SimdClassBase& c)
+    {
+        return SimdClassBase{ Detail::fnmadd<simd_type>(a.data_.simd_,
+                                                        b.data_.simd_,
+                                                        c.data_.simd_) };
+    }
+    friend SimdClassBase fnmsub(const SimdClassBase& a, const SimdClassBase& b,
+                                const SimdClassBase& c)
+    {
+        return SimdClassBase{ Detail::fnmsub<simd_type>(a.data_.simd_,
+                                                        b.data_.simd_,
+                                                        c.data_.simd_) };
+    }
+
     friend SimdClassBase min(const SimdClassBase& a, const SimdClassBase& b)
     {
         return SimdClassBase{ Detail::min<simd_type>(a.data_.simd_,
@@ -381,6 +412,19 @@ protected:
     SimdData<ValueType, tag> data_;
 };
 
+namespace Detail {
+
+// True when func can be called on the whole vector (a generic lambda or a
+// functor taking SimdClass) instead of once per lane. Generic lambdas must
+// then be valid for SimdClass arguments.
+template <typename F, typename SimdClass>
+struct isSimdCallable
+    : std::integral_constant<bool, std::is_invocable_r<SimdClass, const F&, const SimdClass&>::value>
+{
+};
+
+} // namespace Detail
+
 } // namespace SIMD
 } // namespace KFP
 
@@ -0,0 +1,86 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_CONSTANT_H
+#define SIMD_CONSTANT_H
+
+#include "simd_tag.h"
+#include "simd_data.h"
+#include "simd_detail.h"
+#include "simd_class.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace KFP {
+namespace SIMD {
+
+namespace Detail {
+
+// Read-only table with the 32 bit pattern Bits repeated Len times, aligned to
+// Size bytes. There is exactly one table per pattern and vector width, so every
+// use of a constant is a single aligned load (or a broadcast from memory)
+// instead of a value rebuilt at each call site.
+template <std::uint32_t Bits, std::size_t Len, std::size_t Size, typename Indices = std::make_index_sequence<Len>>
+struct ConstantPool;
+
+template <std::uint32_t Bits, std::size_t Len, std::size_t Size, std::size_t... Idx>
+struct ConstantPool<Bits, Len, Size, std::index_sequence<Idx...>>
+{
+    static_assert(Len > 0, "[Error] (KFP::SIMD::Detail::ConstantPool): Invalid length of constant table.");
+    alignas(Size) static constexpr int data[Len]{ ((void)Idx, static_cast<int>(Bits))... };
+};
+
+} // namespace Detail
+
+// Compile-time broadcast constant. Bits is the value for int and the IEEE-754
+// bit pattern for float, e.g. SimdConstantBase<float, 0x40490FDB, tag> is pi.
+template <typename ValueType, std::uint32_t Bits, Tag tag> class SimdConstantBase
+{
+public:
+    typedef ValueType value_type;
+    typedef SimdClassBase<ValueType, tag> simd_class;
+    typedef typename SimdData<ValueType, tag>::simd_type simd_type;
+    typedef typename SimdData<int, tag>::simd_type simd_typei;
+    static constexpr std::uint32_t bits{ Bits };
+
+    // Broadcast register loaded from the constant table
+    static simd_type simd()
+    {
+        return Detail::type_cast<simd_type, simd_typei>(
+            Detail::load_a<simd_typei, int>(pool::data));
+    }
+    static simd_class get()
+    {
+        return simd_class{ simd() };
+    }
+    operator simd_class() const
+    {
+        return get();
+    }
+    // Value of a single lane
+    static ValueType scalar()
+    {
+        ValueType result;
+        std::memcpy(&result, &pool::data[0], sizeof(ValueType));
+        return result;
+    }
+
+private:
+    static_assert(sizeof(ValueType) == sizeof(int),
+                  "[Error] (KFP::SIMD::SimdConstantBase): Only 32 bit value types are supported.");
+    typedef Detail::ConstantPool<Bits, simd_class::SimdLen, simd_class::SimdSize> pool;
+};
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_CONSTANT_H
@@ -12,8 +12,6 @@ Emails: mithran@fias.uni-frankfurt.de
 #include "simd_macros.h"
 #include "simd_tag.h"
 
-#include <x86intrin.h>
-
 namespace KFP
 {
 namespace SIMD
@@ -102,6 +102,15 @@ T1 multiply(const T2 &a, const T3 &b);
 template <typename T1, typename T2 = T1, typename T3 = T1>
 T1 divide(const T2 &a, const T3 &b);
 template <typename T1, typename T2 = T1> T1 minus(const T2 &a);
+/* Fused multiply-add family: a*b+c, a*b-c, -(a*b)+c, -(a*b)-c */
+template <typename T1, typename T2 = T1, typename T3 = T1, typename T4 = T1>
+T1 fmadd(const T2 &a, const T3 &b, const T4 &c);
+template <typename T1, typename T2 = T1, typename T3 = T1, typename T4 = T1>
+T1 fmsub(const T2 &a, const T3 &b, const T4 &c);
+template <typename T1, typename T2 = T1, typename T3 = T1, typename T4 = T1>
+T1 fnmadd(const T2 &a, const T3 &b, const T4 &c);
+template <typename T1, typename T2 = T1, typename T3 = T1, typename T4 = T1>
+T1 fnmsub(const T2 &a, const T3 &b, const T4 &c);
 
 template <typename T1, typename T2 = T1, typename T3 = T1>
 T1 min(const T2 &a, const T3 &b);
@@ -9,8 +9,6 @@ Emails: mithran@fias.uni-frankfurt.de
 #ifndef SIMD_DETECT_H
 #define SIMD_DETECT_H
 
-#include <x86intrin.h>
-
 #ifndef __KFP_SIMD__
 
 #if defined(__AVX2__)
@@ -83,6 +81,10 @@ Emails: mithran@fias.uni-frankfurt.de
 #define __KFP_SIMD__SSE 1
 #endif
 
+#if defined(__KFP_SIMD__SSE)
+#include <x86intrin.h>
+#endif
+
 #if !defined(__KFP_SIMD__Scalar) && !defined(__KFP_SIMD__SSE) && !defined(__KFP_SIMD__AVX)
 #error \
     "[Error] (simd_detect.hpp): Invalid KFParticle SIMD implementation value was selected."
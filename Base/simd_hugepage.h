@@ -0,0 +1,268 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_HUGEPAGE_H
+#define SIMD_HUGEPAGE_H
+
+#include "simd_allocate.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// Large buffers backed by 2 MiB pages, so a pass over a whole event touches
+// few dTLB entries. In order of preference:
+//   HugeTLB          mmap with MAP_HUGETLB, needs pages reserved in
+//                    /proc/sys/vm/nr_hugepages;
+//   TransparentHuge  2 MiB aligned mmap with madvise(MADV_HUGEPAGE), the
+//                    kernel backs it with huge pages when it can;
+//   Mapped           2 MiB aligned mmap, madvise refused (THP disabled);
+//   Heap             alignedAllocate, for small buffers and on other systems.
+// The backing of every mapped buffer is recorded and can be queried with
+// pageBacking().
+
+namespace KFP {
+namespace SIMD {
+
+enum class PageBacking { Heap, Mapped, TransparentHuge, HugeTLB };
+
+constexpr std::size_t HugePageSize{ std::size_t{ 1 } << 21 };
+// Smaller buffers stay on the heap
+constexpr std::size_t HugePageThreshold{ HugePageSize };
+
+namespace Detail {
+
+struct HugePageRecord
+{
+    std::size_t size;
+    PageBacking backing;
+};
+
+// Mapped buffers by address, never destroyed so that buffers of static
+// objects can still be freed at exit
+class HugePageRegistry
+{
+public:
+    static HugePageRegistry& instance()
+    {
+        static HugePageRegistry* registry = new HugePageRegistry;
+        return *registry;
+    }
+    void insert(void* ptr, const HugePageRecord& record)
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        records_[ptr] = record;
+    }
+    bool find(const void* ptr, HugePageRecord& record) const
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        const auto it = records_.find(ptr);
+        if (it == records_.end()) {
+            return false;
+        }
+        record = it->second;
+        return true;
+    }
+    bool erase(const void* ptr, HugePageRecord& record)
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        const auto it = records_.find(ptr);
+        if (it == records_.end()) {
+            return false;
+        }
+        record = it->second;
+        records_.erase(it);
+        return true;
+    }
+
+private:
+    mutable std::mutex mutex_{};
+    std::unordered_map<const void*, HugePageRecord> records_{};
+};
+
+#if defined(__linux__)
+// size is a multiple of HugePageSize, returns nullptr on failure
+inline void* mapHugePages(std::size_t size, PageBacking& backing)
+{
+#if defined(MAP_HUGETLB)
+    void* huge = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (huge != MAP_FAILED) {
+        backing = PageBacking::HugeTLB;
+        return huge;
+    }
+#endif
+    // Over-allocate and trim to a 2 MiB aligned range
+    void* raw = mmap(nullptr, size + HugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return nullptr;
+    }
+    const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(raw);
+    const std::uintptr_t aligned = (begin + HugePageSize - 1) & ~(std::uintptr_t{ HugePageSize } - 1);
+    const std::size_t head = aligned - begin;
+    const std::size_t tail = HugePageSize - head;
+    if (head) {
+        munmap(raw, head);
+    }
+    if (tail) {
+        munmap(reinterpret_cast<void*>(aligned + size), tail);
+    }
+    void* ptr = reinterpret_cast<void*>(aligned);
+    backing = PageBacking::Mapped;
+#if defined(MADV_HUGEPAGE)
+    if (madvise(ptr, size, MADV_HUGEPAGE) == 0) {
+        backing = PageBacking::TransparentHuge;
+    }
+#endif
+    return ptr;
+}
+#endif
+
+} // namespace Detail
+
+// alignedAllocate with huge pages for buffers of at least HugePageThreshold
+// bytes. Returns nullptr on failure; backing, if given, is set to the backing
+// the buffer got. Free with hugePageDeallocate.
+template <std::size_t Alignment>
+inline void* hugePageAllocate(std::size_t size, PageBacking* backing = nullptr)
+{
+    static_assert(isAlignment(Alignment) && Alignment <= HugePageSize,
+                  "[Error] (KFP::SIMD::hugePageAllocate): Invalid value given for aligment");
+    PageBacking result = PageBacking::Heap;
+    void* ptr = nullptr;
+#if defined(__linux__)
+    if (size >= HugePageThreshold) {
+        const std::size_t mapped = (size + HugePageSize - 1) & ~(HugePageSize - 1);
+        ptr = Detail::mapHugePages(mapped, result);
+        if (ptr) {
+            Detail::HugePageRegistry::instance().insert(ptr, Detail::HugePageRecord{ mapped, result });
+        }
+    }
+#endif
+    if (!ptr) {
+        result = PageBacking::Heap;
+        ptr = alignedAllocate<Alignment>(size);
+    }
+    if (backing) {
+        *backing = result;
+    }
+    return ptr;
+}
+
+inline void hugePageDeallocate(void* ptr)
+{
+    if (!ptr) {
+        return;
+    }
+#if defined(__linux__)
+    Detail::HugePageRecord record;
+    if (Detail::HugePageRegistry::instance().erase(ptr, record)) {
+        munmap(ptr, record.size);
+        return;
+    }
+#endif
+    alignedDeallocate(ptr);
+}
+
+// Resizes a buffer from hugePageAllocate to newSize bytes, keeping the first
+// min(oldSize, newSize) bytes. Mapped buffers are resized with mremap, in
+// place when the address range after them is free and otherwise by moving
+// the pages, so nothing is copied. HugeTLB mappings cannot be expanded, and
+// mremap may fail: both fall back, like heap buffers, to a new buffer and a
+// copy. Returns nullptr on failure, the old buffer is then left untouched.
+template <std::size_t Alignment>
+inline void* hugePageReallocate(void* ptr, std::size_t oldSize, std::size_t newSize, PageBacking* backing = nullptr)
+{
+    static_assert(isAlignment(Alignment) && Alignment <= 4096,
+                  "[Error] (KFP::SIMD::hugePageReallocate): Invalid value given for aligment");
+    if (!ptr) {
+        return hugePageAllocate<Alignment>(newSize, backing);
+    }
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+    Detail::HugePageRecord record;
+    if (Detail::HugePageRegistry::instance().find(ptr, record)) {
+        const std::size_t mapped = (newSize > HugePageSize) ? (newSize + HugePageSize - 1) & ~(HugePageSize - 1) : HugePageSize;
+        if (mapped == record.size || (record.backing == PageBacking::HugeTLB && mapped < record.size)) {
+            // Same size, or a HugeTLB mapping that is kept rather than shrunk
+            if (backing) {
+                *backing = record.backing;
+            }
+            return ptr;
+        }
+        if (record.backing != PageBacking::HugeTLB) {
+            void* moved = mremap(ptr, record.size, mapped, MREMAP_MAYMOVE);
+            if (moved != MAP_FAILED) {
+                Detail::HugePageRegistry::instance().erase(ptr, record);
+                Detail::HugePageRegistry::instance().insert(moved, Detail::HugePageRecord{ mapped, record.backing });
+                if (backing) {
+                    *backing = record.backing;
+                }
+                return moved;
+            }
+        }
+    }
+#endif
+    void* grown = hugePageAllocate<Alignment>(newSize, backing);
+    if (grown) {
+        std::memcpy(grown, ptr, (oldSize < newSize) ? oldSize : newSize);
+        hugePageDeallocate(ptr);
+    }
+    return grown;
+}
+
+// Backing of a buffer from hugePageAllocate, Heap for any other pointer
+inline PageBacking pageBacking(const void* ptr)
+{
+    Detail::HugePageRecord record;
+    return Detail::HugePageRegistry::instance().find(ptr, record) ? record.backing : PageBacking::Heap;
+}
+
+inline const char* pageBackingStr(PageBacking backing)
+{
+    switch (backing) {
+    case PageBacking::Mapped:
+        return "Mapped";
+    case PageBacking::TransparentHuge:
+        return "TransparentHuge";
+    case PageBacking::HugeTLB:
+        return "HugeTLB";
+    default:
+        return "Heap";
+    }
+}
+
+// Page policy of AlignedAllocator for large buffers
+struct HugePages
+{
+    template <std::size_t Alignment> static void* allocate(std::size_t size)
+    {
+        void* ptr = hugePageAllocate<Alignment>(size);
+        if (!ptr) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+    static void deallocate(void* ptr, std::size_t /* size */) noexcept
+    {
+        hugePageDeallocate(ptr);
+    }
+};
+
+// Vector<T, Alignment> on huge pages once it grows past HugePageThreshold
+template <typename T, std::size_t Alignment = alignof(T)>
+using HugePageVector = std::vector<T, AlignedAllocator<T, Alignment, HugePages>>;
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_HUGEPAGE_H
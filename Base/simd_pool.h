@@ -0,0 +1,311 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_POOL_H
+#define SIMD_POOL_H
+
+#include "simd_allocate.h"
+#include "simd_macros.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+// Size-class pool for many small objects of the same few sizes, e.g.
+// particle candidates. Blocks of one class are cut from large aligned slabs
+// and recycled through a free list per thread; a thread takes and returns
+// blocks from the global pool BatchSize at a time, so the lock is taken once
+// per batch and not once per object. Blocks freed by another thread than the
+// one that allocated them are simply cached by the freeing thread.
+
+namespace KFP {
+namespace SIMD {
+
+class SimdPool
+{
+public:
+    // Alignment of every pooled block, also the size class granularity
+    static constexpr std::size_t Alignment{ (__KFP_SIMD__Size_Float > 16) ? __KFP_SIMD__Size_Float : 16 };
+    // Larger requests go to alignedAllocate
+    static constexpr std::size_t MaxSize{ 4096 };
+    static constexpr std::size_t NClasses{ MaxSize / Alignment };
+    // Blocks moved between a thread and the global pool at once
+    static constexpr std::size_t BatchSize{ 32 };
+    static constexpr std::size_t SlabSize{ std::size_t{ 1 } << 16 };
+
+    static void* allocate(std::size_t size)
+    {
+        if (size == 0 || size > MaxSize) {
+            return largeAllocate(size);
+        }
+        const std::size_t iClass = sizeClass(size);
+        ThreadCache& cache = threadCache_;
+        Node* node = cache.head[iClass];
+        if (!node) {
+            node = refill(iClass);
+        }
+        cache.head[iClass] = node->next;
+        --cache.count[iClass];
+        return node;
+    }
+    // size must be the size given to allocate
+    static void deallocate(void* ptr, std::size_t size) noexcept
+    {
+        if (!ptr) {
+            return;
+        }
+        if (size == 0 || size > MaxSize) {
+            alignedDeallocate(ptr);
+            return;
+        }
+        const std::size_t iClass = sizeClass(size);
+        Node* node = static_cast<Node*>(ptr);
+        if (threadCacheDestroyed_) {
+            // Static objects destroyed after the thread cache; the block is
+            // leaked if the global pool is out of memory
+            globalPool().put(iClass, Batch{ node, node, 1 });
+            return;
+        }
+        ThreadCache& cache = threadCache_;
+        if (!cache.head[iClass]) {
+            registerThreadCache();
+        }
+        node->next = cache.head[iClass];
+        cache.head[iClass] = node;
+        if (++cache.count[iClass] > 2 * BatchSize) {
+            release(iClass, BatchSize);
+        }
+    }
+
+    // Blocks of the size class of size cached by the calling thread
+    static std::size_t cachedCount(std::size_t size) noexcept
+    {
+        return (size == 0 || size > MaxSize) ? 0 : threadCache_.count[sizeClass(size)];
+    }
+    // Returns all blocks cached by the calling thread to the global pool
+    static void flushThreadCache() noexcept
+    {
+        for (std::size_t iClass = 0; iClass < NClasses; ++iClass) {
+            release(iClass, threadCache_.count[iClass]);
+        }
+    }
+
+private:
+    struct Node
+    {
+        Node* next;
+    };
+    // List of count blocks from first to last
+    struct Batch
+    {
+        Node* first;
+        Node* last;
+        std::size_t count;
+    };
+
+    // Free lists of one thread; trivial, so it needs no guard on access
+    struct ThreadCache
+    {
+        Node* head[NClasses];
+        std::size_t count[NClasses];
+    };
+    // Gives the cache of an exiting thread back to the global pool
+    struct ThreadCacheGuard
+    {
+        ~ThreadCacheGuard()
+        {
+            flushThreadCache();
+            threadCacheDestroyed_ = true;
+        }
+    };
+
+    class GlobalPool
+    {
+    public:
+        bool take(std::size_t iClass, Batch& batch)
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            std::vector<Batch>& batches = batches_[iClass];
+            if (batches.empty()) {
+                return false;
+            }
+            batch = batches.back();
+            batches.pop_back();
+            return true;
+        }
+        // Called from deallocate, which must not throw: false if the batch
+        // could not be stored
+        bool put(std::size_t iClass, const Batch& batch) noexcept
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            try {
+                batches_[iClass].push_back(batch);
+            } catch (const std::bad_alloc&) {
+                return false;
+            }
+            return true;
+        }
+        // Cuts a new slab into blocks of class iClass, keeps all but the
+        // first batch
+        Batch carve(std::size_t iClass)
+        {
+            const std::size_t blockSize = (iClass + 1) * Alignment;
+            const std::size_t nBlocks = (SlabSize / blockSize > BatchSize) ? SlabSize / blockSize : BatchSize;
+            char* slab = static_cast<char*>(alignedAllocate<Alignment>(nBlocks * blockSize));
+            if (!slab) {
+                throw std::bad_alloc();
+            }
+            std::vector<Batch> carved;
+            for (std::size_t begin = 0; begin < nBlocks; begin += BatchSize) {
+                const std::size_t end = (begin + BatchSize < nBlocks) ? begin + BatchSize : nBlocks;
+                for (std::size_t iBlock = begin; iBlock + 1 < end; ++iBlock) {
+                    reinterpret_cast<Node*>(slab + iBlock * blockSize)->next =
+                        reinterpret_cast<Node*>(slab + (iBlock + 1) * blockSize);
+                }
+                Node* last = reinterpret_cast<Node*>(slab + (end - 1) * blockSize);
+                last->next = nullptr;
+                carved.push_back(Batch{ reinterpret_cast<Node*>(slab + begin * blockSize), last, end - begin });
+            }
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            batches_[iClass].insert(batches_[iClass].end(), carved.begin() + 1, carved.end());
+            return carved.front();
+        }
+
+    private:
+        std::mutex mutex_{};
+        std::vector<Batch> batches_[NClasses]{};
+    };
+
+    static std::size_t sizeClass(std::size_t size) noexcept
+    {
+        return (size - 1) / Alignment;
+    }
+    // Never destroyed: slabs may be in use until the very end of the program
+    static GlobalPool& globalPool()
+    {
+        static GlobalPool* pool = new GlobalPool;
+        return *pool;
+    }
+
+    static void* largeAllocate(std::size_t size)
+    {
+        void* ptr = alignedAllocate<Alignment>(size ? size : 1);
+        if (!ptr) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+    // Makes sure the cache of this thread is flushed at thread exit
+    static void registerThreadCache() noexcept
+    {
+        static thread_local ThreadCacheGuard guard;
+        (void)guard;
+    }
+    static Node* refill(std::size_t iClass)
+    {
+        registerThreadCache();
+        Batch batch;
+        if (!globalPool().take(iClass, batch)) {
+            batch = globalPool().carve(iClass);
+        }
+        ThreadCache& cache = threadCache_;
+        batch.last->next = cache.head[iClass];
+        cache.head[iClass] = batch.first;
+        cache.count[iClass] += batch.count;
+        return batch.first;
+    }
+    // Moves count blocks of class iClass from the thread cache to the global
+    // pool as one batch; they stay in the cache if the global pool is out of
+    // memory
+    static void release(std::size_t iClass, std::size_t count) noexcept
+    {
+        if (count == 0) {
+            return;
+        }
+        ThreadCache& cache = threadCache_;
+        Node* first = cache.head[iClass];
+        Node* last = first;
+        for (std::size_t iBlock = 1; iBlock < count; ++iBlock) {
+            last = last->next;
+        }
+        Node* rest = last->next;
+        last->next = nullptr;
+        if (globalPool().put(iClass, Batch{ first, last, count })) {
+            cache.head[iClass] = rest;
+            cache.count[iClass] -= count;
+        } else {
+            last->next = rest;
+        }
+    }
+
+    static inline thread_local ThreadCache threadCache_{};
+    static inline thread_local bool threadCacheDestroyed_{ false };
+};
+
+// Pooled allocation with at least the given alignment; alignments above
+// SimdPool::Alignment are not pooled
+template <std::size_t Alignment> inline void* poolAllocate(std::size_t size)
+{
+    static_assert(isAlignment(Alignment), "[Error] (KFP::SIMD::poolAllocate): Invalid value given for aligment");
+    if constexpr (Alignment <= SimdPool::Alignment) {
+        return SimdPool::allocate(size);
+    } else {
+        void* ptr = alignedAllocate<Alignment>(size);
+        if (!ptr) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+}
+template <std::size_t Alignment> inline void poolDeallocate(void* ptr, std::size_t size) noexcept
+{
+    if constexpr (Alignment <= SimdPool::Alignment) {
+        SimdPool::deallocate(ptr, size);
+    } else {
+        alignedDeallocate(ptr);
+    }
+}
+
+} // namespace SIMD
+} // namespace KFP
+
+// As SETUP_ALIGNED_OPERATOR_NEW_DELETE, but objects come from SimdPool. Only
+// the sized operator delete is declared, so delete always passes the size of
+// the allocation; classes deleted through a base pointer need a virtual
+// destructor, as usual.
+#define SETUP_POOLED_ALIGNED_OPERATOR_NEW_DELETE(Alignment)                                                             \
+    void* operator new(std::size_t size)                                                                                \
+    {                                                                                                                   \
+        return KFP::SIMD::poolAllocate<Alignment>(size);                                                               \
+    }                                                                                                                   \
+    void* operator new[](std::size_t size)                                                                              \
+    {                                                                                                                   \
+        return KFP::SIMD::poolAllocate<Alignment>(size);                                                               \
+    }                                                                                                                   \
+    void operator delete(void* ptr, std::size_t size)                                                                   \
+    {                                                                                                                   \
+        KFP::SIMD::poolDeallocate<Alignment>(ptr, size);                                                               \
+    }                                                                                                                   \
+    void operator delete[](void* ptr, std::size_t size)                                                                 \
+    {                                                                                                                   \
+        KFP::SIMD::poolDeallocate<Alignment>(ptr, size);                                                               \
+    }                                                                                                                   \
+    void* operator new(std::size_t size, void* ptr) { return ::operator new(size, ptr); }                               \
+    void* operator new[](std::size_t size, void* ptr) { return ::operator new[](size, ptr); }                           \
+    void operator delete(void* memory, void* ptr)                                                                       \
+    {                                                                                                                   \
+        return ::operator delete(memory, ptr);                                                                          \
+    }                                                                                                                   \
+    void operator delete[](void* memory, void* ptr)                                                                     \
+    {                                                                                                                   \
+        return ::operator delete[](memory, ptr);                                                                        \
+    }
+
+#endif // !SIMD_POOL_H
@@ -0,0 +1,112 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_PREFETCH_H
+#define SIMD_PREFETCH_H
+
+#include "simd_algorithm.h"
+
+#include <cstddef>
+
+// Software prefetch for latency-bound indirect access, e.g. through daughter
+// index arrays. The hardware prefetcher follows strides but not indices:
+// prefetching the addresses of a gather a few batches ahead overlaps their
+// cache misses with the work on the current batch. The best distance depends
+// on the machine and on the work per batch, see Tests/Bench/bench_prefetch.cpp.
+// Included by simd.h once the backend types are defined.
+
+namespace KFP {
+namespace SIMD {
+
+// Cache level the line is brought to; NonTemporal minimises cache pollution
+enum class PrefetchLevel { L1, L2, L3, NonTemporal };
+
+// Batches ahead prefetched by gather_prefetched when none is given
+constexpr std::size_t DefaultPrefetchDistance{ 8 };
+
+template <PrefetchLevel Level = PrefetchLevel::L1> inline void prefetch(const void* ptr)
+{
+    // Locality hint: 3 keeps the line in all levels, 0 in none
+    constexpr int Locality = (Level == PrefetchLevel::L1) ? 3 : (Level == PrefetchLevel::L2) ? 2 : (Level == PrefetchLevel::L3) ? 1 : 0;
+    __builtin_prefetch(ptr, 0, Locality);
+}
+
+// Prefetches the addresses gather(val_ptr, indices) will read
+template <PrefetchLevel Level = PrefetchLevel::L1, typename T>
+inline void gather_prefetch(const T* val_ptr, const simd_int& indices)
+{
+    __KFP_SIMD__SPEC_ALIGN(simd_int::SimdSize) int index[simd_int::SimdLen]{}; // Helper data array
+    indices.store_a(index);
+    for (int iLane = 0; iLane < simd_int::SimdLen; ++iLane) {
+        prefetch<Level>(val_ptr + index[iLane]);
+    }
+}
+// Only the lanes selected by mask
+template <PrefetchLevel Level = PrefetchLevel::L1, typename T>
+inline void gather_prefetch(const T* val_ptr, const simd_int& indices, const simd_mask& mask)
+{
+    __KFP_SIMD__SPEC_ALIGN(simd_int::SimdSize) int index[simd_int::SimdLen]{}; // Helper data array
+    indices.store_a(index);
+    for (int iLane = 0; iLane < simd_int::SimdLen; ++iLane) {
+        if (mask[iLane]) {
+            prefetch<Level>(val_ptr + index[iLane]);
+        }
+    }
+}
+
+// ------------------------------------------------------
+// Iteration
+// ------------------------------------------------------
+// Calls body(b) for b in [0, nBatches) and prefetch_op(b + distance) before
+// it, as long as b + distance is a batch. distance 0 disables prefetching.
+template <typename PrefetchOp, typename Body>
+inline void prefetched_for(std::size_t nBatches, std::size_t distance, const PrefetchOp& prefetch_op,
+                           const Body& body)
+{
+    std::size_t b = 0;
+    if (distance > 0) {
+        const std::size_t nPrefetched = (nBatches > distance) ? nBatches - distance : 0;
+        for (; b < nPrefetched; ++b) {
+            prefetch_op(b + distance);
+            body(b);
+        }
+    }
+    for (; b < nBatches; ++b) {
+        body(b);
+    }
+}
+
+// Gathers val_ptr[indices[i]] batch by batch and calls func(values, mask,
+// begin) with the batch of elements [begin, begin + SimdLen); mask selects
+// the lanes below size, the others read val_ptr[0]. The gathers of the batch
+// distance batches ahead are prefetched.
+template <PrefetchLevel Level = PrefetchLevel::L1, typename T, typename F>
+inline void gather_prefetched(const T* val_ptr, const int* indices, std::size_t size, const F& func,
+                              std::size_t distance = DefaultPrefetchDistance)
+{
+    using simd_type = Detail::SimdOf<T>;
+    constexpr std::size_t SimdLen = simd_int::SimdLen;
+    const std::size_t nFull = size / SimdLen;
+    prefetched_for(
+        nFull, distance,
+        [&](std::size_t b) { gather_prefetch<Level>(val_ptr, simd_int{}.load(indices + b * SimdLen)); },
+        [&](std::size_t b) {
+            const simd_type values = simd_type{}.gather(val_ptr, simd_int{}.load(indices + b * SimdLen));
+            func(values, simd_mask{ true }, b * SimdLen);
+        });
+    if (nFull * SimdLen < size) {
+        const int n = static_cast<int>(size - nFull * SimdLen);
+        const simd_int index = simd_int{}.load_partial(n, indices + nFull * SimdLen);
+        func(simd_type{}.gather(val_ptr, index), Detail::laneMask(n), nFull * SimdLen);
+    }
+}
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_PREFETCH_H
@@ -0,0 +1,283 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_SOA_H
+#define SIMD_SOA_H
+
+#include "simd_algorithm.h"
+#include "simd_allocate.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Structure of arrays with float/int columns in one aligned allocation. Every
+// column holds capacity() elements, a multiple of SimdLen, so element block i
+// ([i * SimdLen, (i + 1) * SimdLen)) of every column is one aligned batch.
+// Elements past size() are kept zero, the last block can be loaded whole.
+// Included by simd.h once the backend types are defined.
+
+namespace KFP {
+namespace SIMD {
+
+template <typename... Fields> class SoA
+{
+    static_assert(sizeof...(Fields) > 0, "[Error] (KFP::SIMD::SoA): No fields given.");
+    static_assert(((std::is_same<Fields, float>::value || std::is_same<Fields, int>::value) && ...),
+                  "[Error] (KFP::SIMD::SoA): Fields must be float or int.");
+
+public:
+    static constexpr int NFields{ sizeof...(Fields) };
+    static constexpr int SimdLen{ simd_float::SimdLen };
+    static constexpr std::size_t Alignment{ simd_float::SimdSize };
+    template <std::size_t K> using field_type = typename std::tuple_element<K, std::tuple<Fields...>>::type;
+    template <std::size_t K> using simd_type = Detail::SimdOf<field_type<K>>;
+
+    // One element block of every column as simd_float/simd_int
+    class Batch
+    {
+    public:
+        template <std::size_t K> simd_type<K>& get()
+        {
+            return std::get<K>(data_);
+        }
+        template <std::size_t K> const simd_type<K>& get() const
+        {
+            return std::get<K>(data_);
+        }
+
+    private:
+        std::tuple<Detail::SimdOf<Fields>...> data_{};
+    };
+
+    SoA() = default;
+    explicit SoA(std::size_t size)
+    {
+        resize(size);
+    }
+    SoA(const SoA& other)
+    {
+        *this = other;
+    }
+    SoA(SoA&& other) noexcept
+    {
+        swap(other);
+    }
+    SoA& operator=(const SoA& other)
+    {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+            copyColumns(other, other.size_);
+            size_ = other.size_;
+        }
+        return *this;
+    }
+    SoA& operator=(SoA&& other) noexcept
+    {
+        SoA{ std::move(other) }.swap(*this);
+        return *this;
+    }
+    ~SoA()
+    {
+        alignedDeallocate(data_);
+    }
+    void swap(SoA& other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    // ------------------------------------------------------
+    // Size and capacity
+    // ------------------------------------------------------
+    std::size_t size() const
+    {
+        return size_;
+    }
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+    std::size_t capacity() const
+    {
+        return capacity_;
+    }
+    // Number of element blocks, the last one may be partial
+    std::size_t batch_count() const
+    {
+        return (size_ + SimdLen - 1) / SimdLen;
+    }
+    // Lanes of block i holding elements
+    simd_mask batch_mask(std::size_t i) const
+    {
+        const std::size_t begin = i * SimdLen;
+        return Detail::laneMask((size_ > begin) ? static_cast<int>(std::min<std::size_t>(size_ - begin, SimdLen)) : 0);
+    }
+
+    void reserve(std::size_t size)
+    {
+        if (size > capacity_) {
+            reallocate(paddedCapacity(size));
+        }
+    }
+    // New elements are zero
+    void resize(std::size_t size)
+    {
+        if (size > capacity_) {
+            reallocate(paddedCapacity(std::max(size, 2 * capacity_)));
+        } else if (size < size_) {
+            clearRange(size, size_);
+        }
+        size_ = size;
+    }
+    void clear()
+    {
+        clearRange(0, size_);
+        size_ = 0;
+    }
+    void push_back(Fields... values)
+    {
+        if (size_ == capacity_) {
+            reallocate(paddedCapacity(std::max<std::size_t>(2 * capacity_, SimdLen)));
+        }
+        setRow(size_, std::index_sequence_for<Fields...>{}, values...);
+        ++size_;
+    }
+
+    // ------------------------------------------------------
+    // Element access
+    // ------------------------------------------------------
+    template <std::size_t K> field_type<K>* column()
+    {
+        return reinterpret_cast<field_type<K>*>(data_ + columnOffset<K>() * capacity_);
+    }
+    template <std::size_t K> const field_type<K>* column() const
+    {
+        return reinterpret_cast<const field_type<K>*>(data_ + columnOffset<K>() * capacity_);
+    }
+    template <std::size_t K> field_type<K>& get(std::size_t i)
+    {
+        return column<K>()[i];
+    }
+    template <std::size_t K> const field_type<K>& get(std::size_t i) const
+    {
+        return column<K>()[i];
+    }
+
+    // ------------------------------------------------------
+    // Batch access
+    // ------------------------------------------------------
+    // Element block i of every column, lanes past size() are zero
+    Batch batch(std::size_t i) const
+    {
+        assert((i < batch_count()) &&
+               (std::string{ "[Error] (KFP::SIMD::SoA::batch): Block out of range, given: " } + std::to_string(i)).data());
+        Batch result;
+        forEachField([&](auto k) { result.template get<k>().load_a(column<k>() + i * SimdLen); });
+        return result;
+    }
+    // Writes the lanes of batch selected by mask to block i; lanes past size()
+    // are never written
+    void store_batch(std::size_t i, const Batch& batch, const simd_mask& mask)
+    {
+        assert((i < batch_count()) &&
+               (std::string{ "[Error] (KFP::SIMD::SoA::store_batch): Block out of range, given: " } + std::to_string(i)).data());
+        const simd_mask active = mask && batch_mask(i);
+        forEachField([&](auto k) {
+            auto* ptr = column<k>() + i * SimdLen;
+            select(active, batch.template get<k>(), simd_type<k>{}.load_a(ptr)).store_a(ptr);
+        });
+    }
+    void store_batch(std::size_t i, const Batch& batch)
+    {
+        store_batch(i, batch, simd_mask{ true });
+    }
+
+private:
+    static constexpr std::size_t RowSize{ (sizeof(Fields) + ...) };
+
+    // Bytes per element in front of column K
+    template <std::size_t K> static constexpr std::size_t columnOffset()
+    {
+        constexpr std::size_t sizes[sizeof...(Fields)]{ sizeof(Fields)... };
+        std::size_t offset = 0;
+        for (std::size_t k = 0; k < K; ++k) {
+            offset += sizes[k];
+        }
+        return offset;
+    }
+    // func(std::integral_constant<std::size_t, K>) for every column K
+    template <typename F> static void forEachField(F&& func)
+    {
+        forEachFieldImpl(func, std::index_sequence_for<Fields...>{});
+    }
+    template <typename F, std::size_t... K> static void forEachFieldImpl(F& func, std::index_sequence<K...>)
+    {
+        (func(std::integral_constant<std::size_t, K>{}), ...);
+    }
+    static std::size_t paddedCapacity(std::size_t size)
+    {
+        return (size + SimdLen - 1) / SimdLen * SimdLen;
+    }
+
+    template <std::size_t... K> void setRow(std::size_t i, std::index_sequence<K...>, Fields... values)
+    {
+        ((column<K>()[i] = values), ...);
+    }
+    void copyColumns(const SoA& other, std::size_t count)
+    {
+        // memcpy/memset must not see the null columns of an empty SoA
+        if (count == 0 || !data_ || !other.data_) {
+            return;
+        }
+        forEachField([&](auto k) {
+            std::memcpy(column<k>(), other.template column<k>(), count * sizeof(field_type<k>));
+        });
+    }
+    void clearRange(std::size_t begin, std::size_t end)
+    {
+        if (begin >= end || !data_) {
+            return;
+        }
+        forEachField([&](auto k) {
+            std::memset(column<k>() + begin, 0, (end - begin) * sizeof(field_type<k>));
+        });
+    }
+    void reallocate(std::size_t capacity)
+    {
+        SoA grown;
+        grown.data_ = static_cast<char*>(alignedAllocate<Alignment>(capacity * RowSize));
+        if (!grown.data_) {
+            throw std::bad_alloc();
+        }
+        std::memset(grown.data_, 0, capacity * RowSize);
+        grown.capacity_ = capacity;
+        if (data_) {
+            grown.copyColumns(*this, size_);
+        }
+        grown.size_ = size_;
+        swap(grown);
+    }
+
+    char* data_{ nullptr };
+    std::size_t size_{ 0 };
+    std::size_t capacity_{ 0 };
+};
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_SOA_H
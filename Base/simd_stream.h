@@ -0,0 +1,161 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_STREAM_H
+#define SIMD_STREAM_H
+
+#include "simd_algorithm.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#if defined(__unix__)
+#include <unistd.h>
+#endif
+
+// Bulk copy, fill and transform that write with non-temporal stores
+// (store_stream) once the output is too large to stay in the last level
+// cache anyway. Streaming output bypasses the caches, so writing a large
+// result that is not read again soon does not evict the working set. Below
+// the threshold the regular stores are faster. Non-temporal stores need
+// an aligned output and are weakly ordered: every routine ends with
+// streamFence() before the output may be read by another thread. Included by
+// simd.h once the backend types are defined.
+
+namespace KFP {
+namespace SIMD {
+
+namespace Detail {
+
+// Size of the last level cache in bytes, 8 MiB if it cannot be detected
+inline std::size_t detectLastLevelCacheSize()
+{
+    long size = 0;
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+    size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+    if (size <= 0) {
+        size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    }
+#endif
+    return (size > 0) ? static_cast<std::size_t>(size) : (std::size_t{ 8 } << 20);
+}
+
+inline std::atomic<std::size_t>& streamThresholdValue()
+{
+    // Half the cache: the rest holds the input and the working set
+    static std::atomic<std::size_t> threshold{ detectLastLevelCacheSize() / 2 };
+    return threshold;
+}
+
+template <typename T> inline bool useStream(const T* out, std::size_t size)
+{
+    return size * sizeof(T) >= streamThresholdValue().load(std::memory_order_relaxed) && isSimdAligned(out);
+}
+
+} // namespace Detail
+
+// Last level cache size detected at startup
+inline std::size_t lastLevelCacheSize()
+{
+    static const std::size_t size = Detail::detectLastLevelCacheSize();
+    return size;
+}
+// Output size in bytes from which the stream routines use non-temporal stores
+inline std::size_t streamThreshold()
+{
+    return Detail::streamThresholdValue().load(std::memory_order_relaxed);
+}
+inline void setStreamThreshold(std::size_t bytes)
+{
+    Detail::streamThresholdValue().store(bytes, std::memory_order_relaxed);
+}
+
+// Orders the non-temporal stores before all later stores
+inline void streamFence()
+{
+#if defined(__KFP_SIMD__SSE)
+    _mm_sfence();
+#endif
+}
+
+// ------------------------------------------------------
+// stream_copy, stream_fill and stream_transform
+// ------------------------------------------------------
+// Streaming is used when the output has at least streamThreshold() bytes and
+// is aligned to SimdSize; the input may be unaligned. The last partial batch
+// is written with a regular partial store.
+template <typename T> inline void stream_copy(const T* in, T* out, std::size_t size)
+{
+    if (!Detail::useStream(out, size)) {
+        std::memcpy(out, in, size * sizeof(T));
+        return;
+    }
+    using simd_type = Detail::SimdOf<T>;
+    constexpr std::size_t SimdLen = simd_type::SimdLen;
+    std::size_t idx = 0;
+    for (; idx + SimdLen <= size; idx += SimdLen) {
+        simd_type{}.load(in + idx).store_stream(out + idx);
+    }
+    if (idx < size) {
+        const int n = static_cast<int>(size - idx);
+        simd_type{}.load_partial(n, in + idx).store_partial(n, out + idx);
+    }
+    streamFence();
+}
+
+template <typename T> inline void stream_fill(T* out, std::size_t size, T value)
+{
+    if (!Detail::useStream(out, size)) {
+        fill(out, size, value);
+        return;
+    }
+    using simd_type = Detail::SimdOf<T>;
+    constexpr std::size_t SimdLen = simd_type::SimdLen;
+    const simd_type val_simd{ value };
+    std::size_t idx = 0;
+    for (; idx + SimdLen <= size; idx += SimdLen) {
+        val_simd.store_stream(out + idx);
+    }
+    if (idx < size) {
+        val_simd.store_partial(static_cast<int>(size - idx), out + idx);
+    }
+    streamFence();
+}
+
+// out[i] = func(in[i]) as in transform; in and out must not overlap
+template <typename T, typename F> inline void stream_transform(const T* in, T* out, std::size_t size, const F& func)
+{
+    if (!Detail::useStream(out, size)) {
+        transform(in, out, size, func);
+        return;
+    }
+    using simd_type = Detail::SimdOf<T>;
+    constexpr std::size_t SimdLen = simd_type::SimdLen;
+    std::size_t idx = 0;
+    if (Detail::isSimdAligned(in)) {
+        for (; idx + SimdLen <= size; idx += SimdLen) {
+            apply(simd_type{}.load_a(in + idx), func).store_stream(out + idx);
+        }
+    } else {
+        for (; idx + SimdLen <= size; idx += SimdLen) {
+            apply(simd_type{}.load(in + idx), func).store_stream(out + idx);
+        }
+    }
+    if (idx < size) {
+        const int n = static_cast<int>(size - idx);
+        apply(simd_type{}.load_partial(n, in + idx), func).store_partial(n, out + idx);
+    }
+    streamFence();
+}
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_STREAM_H
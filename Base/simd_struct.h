@@ -0,0 +1,237 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_STRUCT_H
+#define SIMD_STRUCT_H
+
+#include "simd_soa.h"
+
+#include <cassert>
+#include <cstddef>
+#include <string>
+
+// KFP_SIMD_STRUCT(Name, (type, field), ...) declares, for up to 32 float/int
+// fields:
+//   Name       the scalar struct, plus the enum Name::field_<field> of field
+//              indices and Name::NFields
+//   Name##SoA  SoA<type...> with the column accessors field() and push_back,
+//              get and set of whole Name records
+//   Name##Simd one simd_float/simd_int member per field, with load/store of
+//              element blocks of Name##SoA (optionally masked), gather/scatter
+//              by simd_int index, lane access as Name, loadAoS/storeAoS of Name
+//              arrays and select
+// Field names must not clash with the member functions of these types.
+// Included by simd.h once the backend types are defined.
+
+// ------------------------------------------------------
+// Preprocessor helpers
+// ------------------------------------------------------
+#define __KFP_SIMD__PP_CAT_I(a, b) a##b
+#define __KFP_SIMD__PP_CAT(a, b) __KFP_SIMD__PP_CAT_I(a, b)
+#define __KFP_SIMD__PP_EMPTY()
+#define __KFP_SIMD__PP_COMMA() ,
+#define __KFP_SIMD__PP_TYPE_I(type, name) type
+#define __KFP_SIMD__PP_NAME_I(type, name) name
+// field is (type, name)
+#define __KFP_SIMD__PP_TYPE(field) __KFP_SIMD__PP_TYPE_I field
+#define __KFP_SIMD__PP_NAME(field) __KFP_SIMD__PP_NAME_I field
+
+#define __KFP_SIMD__PP_NARG_I(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, N, ...) N
+#define __KFP_SIMD__PP_NARG(...) __KFP_SIMD__PP_NARG_I(__VA_ARGS__, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
+
+// M(field) for every field, separated by S()
+#define __KFP_SIMD__PP_FOR_EACH(M, S, ...) \
+    __KFP_SIMD__PP_CAT(__KFP_SIMD__PP_FE_, __KFP_SIMD__PP_NARG(__VA_ARGS__))(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_1(M, S, f) M(f)
+#define __KFP_SIMD__PP_FE_2(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_1(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_3(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_2(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_4(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_3(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_5(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_4(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_6(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_5(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_7(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_6(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_8(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_7(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_9(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_8(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_10(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_9(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_11(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_10(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_12(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_11(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_13(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_12(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_14(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_13(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_15(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_14(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_16(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_15(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_17(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_16(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_18(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_17(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_19(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_18(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_20(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_19(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_21(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_20(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_22(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_21(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_23(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_22(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_24(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_23(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_25(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_24(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_26(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_25(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_27(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_26(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_28(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_27(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_29(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_28(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_30(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_29(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_31(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_30(M, S, __VA_ARGS__)
+#define __KFP_SIMD__PP_FE_32(M, S, f, ...) M(f) S() __KFP_SIMD__PP_FE_31(M, S, __VA_ARGS__)
+
+// Per field pieces of KFP_SIMD_STRUCT
+#define __KFP_SIMD__PP_FIELD_INDEX(field) __KFP_SIMD__PP_CAT(field_, __KFP_SIMD__PP_NAME(field))
+#define __KFP_SIMD__PP_SCALAR_MEMBER(field) __KFP_SIMD__PP_TYPE(field) __KFP_SIMD__PP_NAME(field);
+#define __KFP_SIMD__PP_SIMD_MEMBER(field) KFP::SIMD::Detail::SimdOf<__KFP_SIMD__PP_TYPE(field)> __KFP_SIMD__PP_NAME(field){};
+#define __KFP_SIMD__PP_SOA_COLUMN(field)                                                                    \
+    __KFP_SIMD__PP_TYPE(field)* __KFP_SIMD__PP_NAME(field)()                                                \
+    {                                                                                                       \
+        return this->template column<record_type::__KFP_SIMD__PP_FIELD_INDEX(field)>();                     \
+    }                                                                                                       \
+    const __KFP_SIMD__PP_TYPE(field)* __KFP_SIMD__PP_NAME(field)() const                                    \
+    {                                                                                                       \
+        return this->template column<record_type::__KFP_SIMD__PP_FIELD_INDEX(field)>();                     \
+    }
+#define __KFP_SIMD__PP_RECORD_VALUE(field) record.__KFP_SIMD__PP_NAME(field)
+#define __KFP_SIMD__PP_SOA_ELEMENT(field) __KFP_SIMD__PP_NAME(field)()[i]
+#define __KFP_SIMD__PP_SOA_SET(field) __KFP_SIMD__PP_NAME(field)()[i] = record.__KFP_SIMD__PP_NAME(field);
+#define __KFP_SIMD__PP_SIMD_LOAD(field) \
+    __KFP_SIMD__PP_NAME(field).load_a(soa.__KFP_SIMD__PP_NAME(field)() + b * SimdLen);
+#define __KFP_SIMD__PP_SIMD_STORE(field) \
+    merged.__KFP_SIMD__PP_NAME(field).store_a(soa.__KFP_SIMD__PP_NAME(field)() + b * SimdLen);
+#define __KFP_SIMD__PP_SIMD_GATHER(field) \
+    __KFP_SIMD__PP_NAME(field).gather(soa.__KFP_SIMD__PP_NAME(field)(), index);
+#define __KFP_SIMD__PP_SIMD_SCATTER(field) \
+    __KFP_SIMD__PP_NAME(field).scatter(soa.__KFP_SIMD__PP_NAME(field)(), index);
+#define __KFP_SIMD__PP_SIMD_LANE(field) __KFP_SIMD__PP_NAME(field)[iLane]
+#define __KFP_SIMD__PP_SIMD_SET_LANE(field) \
+    __KFP_SIMD__PP_NAME(field).insert(iLane, record.__KFP_SIMD__PP_NAME(field));
+#define __KFP_SIMD__PP_SIMD_SELECT(field) \
+    result.__KFP_SIMD__PP_NAME(field) = select(mask, a.__KFP_SIMD__PP_NAME(field), b.__KFP_SIMD__PP_NAME(field));
+
+// ------------------------------------------------------
+// KFP_SIMD_STRUCT
+// ------------------------------------------------------
+#define KFP_SIMD_STRUCT(Name, ...)                                                                          \
+    struct Name                                                                                             \
+    {                                                                                                       \
+        enum Field : int                                                                                    \
+        {                                                                                                   \
+            __KFP_SIMD__PP_FOR_EACH(__KFP_SIMD__PP_FIELD_INDEX, __KFP_SIMD__PP_COMMA, __VA_ARGS__),         \
+            NFields                                                                                         \
+        };                                                                                                  \
+        __KFP_SIMD__PP_FOR_EACH(__KFP_SIMD__PP_SCALAR_MEMBER, __KFP_SIMD__PP_EMPTY, __VA_ARGS__)            \
+    };                                                                                                      \
+                                                                                                            \
+    struct Name##SoA                                                                                        \
+        : KFP::SIMD::SoA<__KFP_SIMD__PP_FOR_EACH(__KFP_SIMD__PP_TYPE, __KFP_SIMD__PP_COMMA, __VA_ARGS__)>   \
+    {                                                                                                       \
+        typedef Name record_type;                                                                           \
+        typedef KFP::SIMD::SoA<__KFP_SIMD__PP_FOR_EACH(__KFP_SIMD__PP_TYPE, __KFP_SIMD__PP_COMMA,           \
+                                                       __VA_ARGS__)>                                        \
+            soa_type;                                                                                       \
+        using soa_type::soa_type;                                                                           \
+        using soa_type::push_back;                                                                          \
+                                                                                                            \
+        __KFP_SIMD__PP_FOR_EACH(__KFP_SIMD__PP_SOA_COLUMN, __KFP_SIMD__PP_EMPTY, __VA_ARGS__)               \
+                                                                                                            \
+        void push_back(const record_type& record)                                                           \
+        {                                                                                                   \
+            push_back(__KFP_SIMD__PP_FOR_EACH(__KFP_SIMD__PP_RECORD_VALUE, __KFP_SIMD__PP_COMMA,            \
+                                              __VA_ARGS__));                                                \
+        }                                                                                                   \
+        record_type record(std::size_t i) const                                                             \
+        {                                                                                                   \
+            return record_type{ __KFP_SIMD__PP_FOR_EACH(__KFP_SIMD__PP_SOA_ELEMENT, __KFP_SIMD__PP_COMMA,   \
+                                                        __VA_ARGS__) };                                     \
+        }                                                                                                   \
+        void setRecord(std::size_t i, const record_type& record)                                            \
+        {                                                                                                   \
+            __KFP_SIMD__PP_FOR_EACH(__KFP_SIMD__PP_SOA_SET, __KFP_SIMD__PP_EMPTY, __VA_ARGS__)              \
+        }                                                                                                   \
+    };                                                                                                      \
+                                                                                                            \
+    struct Name##Simd                                                                                       \
+    {                                                                                                       \
+        typedef Name record_type;                                                                           \
+        typedef Name##SoA soa_type;                                                                         \
+        static constexpr int SimdLen{ KFP::SIMD::simd_float::SimdLen };                                     \
+                                                                                                            \
+        __KFP_SIMD__PP_FOR_EACH(__KFP_SIMD__PP_SIMD_MEMBER, __KFP_SIMD__PP_EMPTY, __VA_ARGS__)              \
+                                                                                                            \
+        /* Element block b of soa */                                                                        \
+        Name##Simd& load(const soa_type& soa, std::size_t b)                                                \
+        {                                                                                                   \
+            __KFP_SIMD__PP_FOR_EACH(__KFP_SIMD__PP_SIMD_LOAD, __KFP_SIMD__PP_EMPTY, __VA_ARGS__)            \
+            return *this;                                                                                   \
+        }                                                                                                   \
+        void store(soa_type& soa, std::size_t b) const                                                      \
+        {                                                                                                   \
+            store(soa, b, KFP::SIMD::simd_mask{ true });                                                    \
+        }                                                                                                   \
+        /* Only lanes selected by mask and below soa.size() are written */                                  \
+        void store(soa_type& soa, std::size_t b, const KFP::SIMD::simd_mask& mask) const                    \
+        {                                                                                                   \
+            const Name##Simd merged = select(mask && soa.batch_mask(b), *this, Name##Simd{}.load(soa, b));  \
+            __KFP_SIMD__PP_FOR_EACH(__KFP_SIMD__PP_SIMD_STORE, __KFP_SIMD__PP_EMPTY, __VA_ARGS__)           \
+        }                                                                                                   \
+        Name##Simd& gather(const soa_type& soa, const KFP::SIMD::simd_int& index)                           \
+        {                                                                                                   \
+            __KFP_SIMD__PP_FOR_EACH(__KFP_SIMD__PP_SIMD_GATHER, __KFP_SIMD__PP_EMPTY, __VA_ARGS__)          \
+            return *this;                                                                                   \
+        }                                                                                                   \
+        /* Lanes with equal indices: the last one wins */                                                   \
+        void scatter(soa_type& soa, const KFP::SIMD::simd_int& index) const                                 \
+        {                                                                                                   \
+            __KFP_SIMD__PP_FOR_EACH(__KFP_SIMD__PP_SIMD_SCATTER, __KFP_SIMD__PP_EMPTY, __VA_ARGS__)         \
+        }                                                                                                   \
+        void scatter(soa_type& soa, const KFP::SIMD::simd_int& index, const KFP::SIMD::simd_mask& mask) const \
+        {                                                                                                   \
+            for (int iLane = 0; iLane < SimdLen; ++iLane) {                                                 \
+                if (mask[iLane]) {                                                                          \
+                    assert((index[iLane] >= 0) &&                                                           \
+                           (std::string{ "[Error] (KFP::SIMD::" #Name "Simd::scatter): Negative index, "    \
+                                         "given: " } +                                                      \
+                            std::to_string(index[iLane]))                                                   \
+                               .data());                                                                    \
+                    soa.setRecord(static_cast<std::size_t>(index[iLane]), get(iLane));                      \
+                }                                                                                           \
+            }                                                                                               \
+        }                                                                                                   \
+                                                                                                            \
+        record_type get(int iLane) const                                                                    \
+        {                                                                                                   \
+            return record_type{ __KFP_SIMD__PP_FOR_EACH(__KFP_SIMD__PP_SIMD_LANE, __KFP_SIMD__PP_COMMA,     \
+                                                        __VA_ARGS__) };                                     \
+        }                                                                                                   \
+        Name##Simd& set(int iLane, const record_type& record)                                               \
+        {                                                                                                   \
+            __KFP_SIMD__PP_FOR_EACH(__KFP_SIMD__PP_SIMD_SET_LANE, __KFP_SIMD__PP_EMPTY, __VA_ARGS__)        \
+            return *this;                                                                                   \
+        }                                                                                                   \
+        /* Records [0, n) to lanes [0, n), the other lanes are zero */                                      \
+        Name##Simd& loadAoS(const record_type* records, int n = SimdLen)                                    \
+        {                                                                                                   \
+            *this = Name##Simd{};                                                                           \
+            for (int iLane = 0; iLane < n; ++iLane) {                                                       \
+                set(iLane, records[iLane]);                                                                 \
+            }                                                                                               \
+            return *this;                                                                                   \
+        }                                                                                                   \
+        void storeAoS(record_type* records, int n = SimdLen) const                                          \
+        {                                                                                                   \
+            for (int iLane = 0; iLane < n; ++iLane) {                                                       \
+                records[iLane] = get(iLane);                                                                \
+            }                                                                                               \
+        }                                                                                                   \
+                                                                                                            \
+        friend Name##Simd select(const KFP::SIMD::simd_mask& mask, const Name##Simd& a, const Name##Simd& b) \
+        {                                                                                                   \
+            Name##Simd result;                                                                              \
+            __KFP_SIMD__PP_FOR_EACH(__KFP_SIMD__PP_SIMD_SELECT, __KFP_SIMD__PP_EMPTY, __VA_ARGS__)          \
+            return result;                                                                                  \
+        }                                                                                                   \
+    };
+
+#endif // !SIMD_STRUCT_H
@@ -0,0 +1,344 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_VECTOR_H
+#define SIMD_VECTOR_H
+
+#include "simd_algorithm.h"
+#include "simd_hugepage.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// Vector of float or int for batch processing. The storage is aligned to
+// SimdSize and holds whole batches: the elements [size(), padded_size()) of
+// the last batch always hold padding(). Every batch can be loaded with load_a
+// and written with a full-width store_a, so loops over batches() need no
+// epilogue. Storage grows through hugePageReallocate, like Buffer. Included by
+// simd.h once the backend types are defined.
+
+namespace KFP {
+namespace SIMD {
+
+template <typename T> class SimdVector
+{
+    static_assert(std::is_same<T, float>::value || std::is_same<T, int>::value,
+                  "[Error] (KFP::SIMD::SimdVector): Type must be float or int.");
+
+public:
+    typedef T value_type;
+    typedef Detail::SimdOf<T> simd_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    static constexpr int SimdLen{ simd_type::SimdLen };
+    static constexpr std::size_t Alignment{ simd_type::SimdSize };
+
+    // One batch of a SimdVector, stores keep the padding
+    class BatchRef
+    {
+    public:
+        BatchRef(T* ptr, int count, T padding) : ptr_{ ptr }, count_{ count }, padding_{ padding } {}
+
+        simd_type load() const
+        {
+            return simd_type{}.load_a(ptr_);
+        }
+        void store(const simd_type& val_simd) const
+        {
+            if (count_ == SimdLen) {
+                val_simd.store_a(ptr_);
+            } else {
+                select(Detail::laneMask(count_), val_simd, simd_type{ padding_ }).store_a(ptr_);
+            }
+        }
+        // Lanes holding elements
+        simd_mask mask() const
+        {
+            return Detail::laneMask(count_);
+        }
+        T* data() const
+        {
+            return ptr_;
+        }
+
+    private:
+        T* ptr_;
+        int count_;
+        T padding_;
+    };
+
+    class BatchIterator
+    {
+    public:
+        BatchIterator(SimdVector* vector, std::size_t b) : vector_{ vector }, b_{ b } {}
+
+        BatchRef operator*() const
+        {
+            return vector_->batch_ref(b_);
+        }
+        BatchIterator& operator++()
+        {
+            ++b_;
+            return *this;
+        }
+        bool operator==(const BatchIterator& other) const
+        {
+            return b_ == other.b_;
+        }
+        bool operator!=(const BatchIterator& other) const
+        {
+            return b_ != other.b_;
+        }
+
+    private:
+        SimdVector* vector_;
+        std::size_t b_;
+    };
+
+    struct BatchRange
+    {
+        BatchIterator first;
+        BatchIterator last;
+        BatchIterator begin() const
+        {
+            return first;
+        }
+        BatchIterator end() const
+        {
+            return last;
+        }
+    };
+
+    SimdVector() = default;
+    explicit SimdVector(std::size_t size, T value = T{ 0 }, T padding = T{ 0 }) : padding_{ padding }
+    {
+        resize(size, value);
+    }
+    SimdVector(const SimdVector& other)
+    {
+        *this = other;
+    }
+    SimdVector(SimdVector&& other) noexcept
+    {
+        swap(other);
+    }
+    SimdVector& operator=(const SimdVector& other)
+    {
+        if (this != &other) {
+            size_ = 0;
+            padding_ = other.padding_;
+            reserve(other.size_);
+            std::copy(other.data_, other.data_ + paddedSize(other.size_), data_);
+            size_ = other.size_;
+        }
+        return *this;
+    }
+    SimdVector& operator=(SimdVector&& other) noexcept
+    {
+        SimdVector{ std::move(other) }.swap(*this);
+        return *this;
+    }
+    ~SimdVector()
+    {
+        hugePageDeallocate(data_);
+    }
+    void swap(SimdVector& other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(padding_, other.padding_);
+    }
+
+    // ------------------------------------------------------
+    // Size and capacity
+    // ------------------------------------------------------
+    std::size_t size() const
+    {
+        return size_;
+    }
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+    // size() rounded up to whole batches
+    std::size_t padded_size() const
+    {
+        return paddedSize(size_);
+    }
+    // Always a multiple of SimdLen
+    std::size_t capacity() const
+    {
+        return capacity_;
+    }
+    std::size_t batch_count() const
+    {
+        return paddedSize(size_) / SimdLen;
+    }
+    T padding() const
+    {
+        return padding_;
+    }
+    // Rewrites the padding of the last batch
+    void set_padding(T padding)
+    {
+        padding_ = padding;
+        std::fill(data_ + size_, data_ + paddedSize(size_), padding_);
+    }
+
+    void reserve(std::size_t size)
+    {
+        if (size > capacity_) {
+            reallocate(paddedSize(size));
+        }
+    }
+    void resize(std::size_t size, T value = T{ 0 })
+    {
+        if (size > capacity_) {
+            reallocate(paddedSize(std::max(size, 2 * capacity_)));
+        }
+        if (size > size_) {
+            std::fill(data_ + size_, data_ + size, value);
+        }
+        std::fill(data_ + size, data_ + paddedSize(size), padding_);
+        size_ = size;
+    }
+    void clear()
+    {
+        resize(0);
+    }
+    void push_back(T value)
+    {
+        if (size_ == capacity_) {
+            reallocate(std::max<std::size_t>(2 * capacity_, SimdLen));
+        }
+        // Starting a new batch: slots past the old padded size may hold stale
+        // elements from before a shrink, or nothing at all after growth
+        if (size_ % SimdLen == 0) {
+            std::fill(data_ + size_, data_ + size_ + SimdLen, padding_);
+        }
+        data_[size_++] = value;
+    }
+    void pop_back()
+    {
+        data_[--size_] = padding_;
+    }
+
+    // ------------------------------------------------------
+    // Element access
+    // ------------------------------------------------------
+    T* data()
+    {
+        return data_;
+    }
+    const T* data() const
+    {
+        return data_;
+    }
+    T& operator[](std::size_t i)
+    {
+        return data_[i];
+    }
+    const T& operator[](std::size_t i) const
+    {
+        return data_[i];
+    }
+    T& back()
+    {
+        return data_[size_ - 1];
+    }
+    const T& back() const
+    {
+        return data_[size_ - 1];
+    }
+    iterator begin()
+    {
+        return data_;
+    }
+    iterator end()
+    {
+        return data_ + size_;
+    }
+    const_iterator begin() const
+    {
+        return data_;
+    }
+    const_iterator end() const
+    {
+        return data_ + size_;
+    }
+
+    // ------------------------------------------------------
+    // Batch access
+    // ------------------------------------------------------
+    // Batch b, lanes past size() hold padding()
+    simd_type batch(std::size_t b) const
+    {
+        assert((b < batch_count()) &&
+               (std::string{ "[Error] (KFP::SIMD::SimdVector::batch): Batch out of range, given: " } + std::to_string(b))
+                   .data());
+        return simd_type{}.load_a(data_ + b * SimdLen);
+    }
+    void store_batch(std::size_t b, const simd_type& val_simd)
+    {
+        assert((b < batch_count()) &&
+               (std::string{ "[Error] (KFP::SIMD::SimdVector::store_batch): Batch out of range, given: " } +
+                std::to_string(b))
+                   .data());
+        batch_ref(b).store(val_simd);
+    }
+    simd_mask batch_mask(std::size_t b) const
+    {
+        return Detail::laneMask(batchCount(b));
+    }
+    BatchRef batch_ref(std::size_t b)
+    {
+        return BatchRef{ data_ + b * SimdLen, batchCount(b), padding_ };
+    }
+    // for (auto batch : vector.batches()) { batch.store(batch.load() * 2.0f); }
+    BatchRange batches()
+    {
+        return BatchRange{ BatchIterator{ this, 0 }, BatchIterator{ this, batch_count() } };
+    }
+
+private:
+    static std::size_t paddedSize(std::size_t size)
+    {
+        return (size + SimdLen - 1) / SimdLen * SimdLen;
+    }
+    int batchCount(std::size_t b) const
+    {
+        const std::size_t begin = b * SimdLen;
+        return (size_ > begin) ? static_cast<int>(std::min<std::size_t>(size_ - begin, SimdLen)) : 0;
+    }
+    // capacity is a multiple of SimdLen
+    void reallocate(std::size_t capacity)
+    {
+        void* grown = hugePageReallocate<Alignment>(data_, paddedSize(size_) * sizeof(T), capacity * sizeof(T));
+        if (!grown) {
+            throw std::bad_alloc();
+        }
+        data_ = static_cast<T*>(grown);
+        capacity_ = capacity;
+    }
+
+    T* data_{ nullptr };
+    std::size_t size_{ 0 };
+    std::size_t capacity_{ 0 };
+    T padding_{ 0 };
+};
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_VECTOR_H
@@ -0,0 +1,132 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_CHOLESKY_H
+#define SIMD_CHOLESKY_H
+
+#include "simd_matrix.h"
+
+namespace KFP {
+namespace SIMD {
+
+// Cholesky factorization A = L L^T of SimdLen symmetric matrices at once.
+// Lanes which are not positive definite (including NaN input) are cleared in
+// valid(); their pivots are replaced by one so that the other lanes carry on
+// without a branch. Results of invalid lanes are set to zero.
+template <int N> class SimdCholesky
+{
+public:
+    explicit SimdCholesky(const SimdSymMatrix<N>& A) : L_{}, valid_{ true }
+    {
+        const simd_float zero{ 0.0f };
+        const simd_float one{ 1.0f };
+        // L is kept packed in the same lower triangle layout as A
+        Detail::staticFor<N>([&](auto j) {
+            simd_float diag = A(j, j);
+            Detail::staticFor<j>([&](auto k) { diag = fnmadd(L_(j, k), L_(j, k), diag); });
+            const simd_mask positive = diag > zero;
+            valid_ &= positive;
+            diag = select(positive, diag, one);
+            L_(j, j) = sqrt(diag);
+            invDiag_[j] = one / L_(j, j);
+            Detail::staticFor<N - j - 1>([&](auto i0) {
+                constexpr int i = j + 1 + i0;
+                simd_float sum = A(i, j);
+                Detail::staticFor<j>([&](auto k) { sum = fnmadd(L_(i, k), L_(j, k), sum); });
+                L_(i, j) = sum * invDiag_[j];
+            });
+        });
+    }
+
+    // Lanes in which A is positive definite
+    const simd_mask& valid() const
+    {
+        return valid_;
+    }
+    // Element (i, j), i >= j, of the lower triangular factor
+    const simd_float& L(int i, int j) const
+    {
+        return L_(i, j);
+    }
+
+    // Solves A X = B by forward and back substitution
+    template <int Cols> SimdMatrix<N, Cols> solve(const SimdMatrix<N, Cols>& B) const
+    {
+        SimdMatrix<N, Cols> X;
+        const simd_float zero{ 0.0f };
+        Detail::staticFor<Cols>([&](auto c) {
+            // L y = b
+            Detail::staticFor<N>([&](auto i) {
+                simd_float sum = B(i, c);
+                Detail::staticFor<i>([&](auto k) { sum = fnmadd(L_(i, k), X(k, c), sum); });
+                X(i, c) = sum * invDiag_[i];
+            });
+            // L^T x = y
+            Detail::staticFor<N>([&](auto i0) {
+                constexpr int i = N - 1 - i0;
+                simd_float sum = X(i, c);
+                Detail::staticFor<i0>([&](auto k0) {
+                    constexpr int k = N - 1 - k0;
+                    sum = fnmadd(L_(k, i), X(k, c), sum);
+                });
+                X(i, c) = select(valid_, sum * invDiag_[i], zero);
+            });
+        });
+        return X;
+    }
+
+    // A^-1 = L^-T L^-1
+    SimdSymMatrix<N> inverse() const
+    {
+        // Inverse of the factor, lower triangular as well
+        SimdSymMatrix<N> Linv;
+        Detail::staticFor<N>([&](auto j) {
+            Linv(j, j) = invDiag_[j];
+            Detail::staticFor<N - j - 1>([&](auto i0) {
+                constexpr int i = j + 1 + i0;
+                simd_float sum = L_(i, j) * Linv(j, j);
+                Detail::staticFor<i - j - 1>([&](auto k0) {
+                    constexpr int k = j + 1 + k0;
+                    sum = fmadd(L_(i, k), Linv(k, j), sum);
+                });
+                Linv(i, j) = -sum * invDiag_[i];
+            });
+        });
+        SimdSymMatrix<N> result;
+        const simd_float zero{ 0.0f };
+        Detail::staticFor<N>([&](auto i) {
+            Detail::staticFor<i + 1>([&](auto j) {
+                simd_float sum = Linv(i, i) * Linv(i, j);
+                Detail::staticFor<N - i - 1>([&](auto k0) {
+                    constexpr int k = i + 1 + k0;
+                    sum = fmadd(Linv(k, i), Linv(k, j), sum);
+                });
+                result(i, j) = select(valid_, sum, zero);
+            });
+        });
+        return result;
+    }
+
+private:
+    SimdSymMatrix<N> L_;
+    simd_float invDiag_[static_cast<std::size_t>(N)];
+    simd_mask valid_;
+};
+
+// Inverts A in place, returns the lanes in which A was positive definite
+template <int N> inline simd_mask invertCholesky(SimdSymMatrix<N>& A)
+{
+    const SimdCholesky<N> cholesky{ A };
+    A = cholesky.inverse();
+    return cholesky.valid();
+}
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_CHOLESKY_H
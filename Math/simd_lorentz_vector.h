@@ -0,0 +1,407 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_LORENTZ_VECTOR_H
+#define SIMD_LORENTZ_VECTOR_H
+
+#include "simd_math.h"
+#include "simd_matrix.h"
+
+#include <cstddef>
+
+// Three-vectors and Lorentz vectors of SimdLen particles, one particle per
+// lane, with the kinematic quantities used in candidate selection. Angles
+// and pseudorapidity follow the ROOT TVector3/TLorentzVector conventions.
+
+namespace KFP {
+namespace SIMD {
+
+// ------------------------------------------------------
+// Three-vector
+// ------------------------------------------------------
+class SimdVec3
+{
+public:
+    static constexpr int Size{ 3 };
+
+    SimdVec3() : data_{ simd_float{ 0.0f }, simd_float{ 0.0f }, simd_float{ 0.0f } } {}
+    SimdVec3(const simd_float& x, const simd_float& y, const simd_float& z) : data_{ x, y, z } {}
+
+    simd_float& x()
+    {
+        return data_[0];
+    }
+    const simd_float& x() const
+    {
+        return data_[0];
+    }
+    simd_float& y()
+    {
+        return data_[1];
+    }
+    const simd_float& y() const
+    {
+        return data_[1];
+    }
+    simd_float& z()
+    {
+        return data_[2];
+    }
+    const simd_float& z() const
+    {
+        return data_[2];
+    }
+    simd_float& operator[](int k)
+    {
+        return data_[k];
+    }
+    const simd_float& operator[](int k) const
+    {
+        return data_[k];
+    }
+
+    // ------------------------------------------------------
+    // Load and Store
+    // ------------------------------------------------------
+    // (x, y, z) of lane l at val_ptr + l * stride (AoS)
+    SimdVec3& loadAoS(const float* val_ptr, int n = simd_float::SimdLen, std::size_t stride = Size)
+    {
+        Detail::loadAoS(data_, val_ptr, n, stride);
+        return *this;
+    }
+    void storeAoS(float* val_ptr, int n = simd_float::SimdLen, std::size_t stride = Size) const
+    {
+        Detail::storeAoS(data_, val_ptr, n, stride);
+    }
+    // Component k of all lanes at val_ptr + k * stride (SoA)
+    SimdVec3& loadSoA(const float* val_ptr, std::size_t stride)
+    {
+        Detail::staticFor<Size>([&](auto k) { data_[k].load(val_ptr + k * stride); });
+        return *this;
+    }
+    void storeSoA(float* val_ptr, std::size_t stride) const
+    {
+        Detail::staticFor<Size>([&](auto k) { data_[k].store(val_ptr + k * stride); });
+    }
+
+    // ------------------------------------------------------
+    // Arithmetic
+    // ------------------------------------------------------
+    SimdVec3& operator+=(const SimdVec3& other)
+    {
+        Detail::staticFor<Size>([&](auto k) { data_[k] += other.data_[k]; });
+        return *this;
+    }
+    SimdVec3& operator-=(const SimdVec3& other)
+    {
+        Detail::staticFor<Size>([&](auto k) { data_[k] -= other.data_[k]; });
+        return *this;
+    }
+    SimdVec3& operator*=(const simd_float& factor)
+    {
+        Detail::staticFor<Size>([&](auto k) { data_[k] *= factor; });
+        return *this;
+    }
+    friend SimdVec3 operator+(SimdVec3 a, const SimdVec3& b)
+    {
+        return a += b;
+    }
+    friend SimdVec3 operator-(SimdVec3 a, const SimdVec3& b)
+    {
+        return a -= b;
+    }
+    friend SimdVec3 operator-(const SimdVec3& a)
+    {
+        return SimdVec3{ -a.x(), -a.y(), -a.z() };
+    }
+    friend SimdVec3 operator*(SimdVec3 a, const simd_float& factor)
+    {
+        return a *= factor;
+    }
+    friend SimdVec3 operator*(const simd_float& factor, SimdVec3 a)
+    {
+        return a *= factor;
+    }
+    friend SimdVec3 operator/(SimdVec3 a, const simd_float& divisor)
+    {
+        return a *= simd_float{ 1.0f } / divisor;
+    }
+
+    friend simd_float dot(const SimdVec3& a, const SimdVec3& b)
+    {
+        return fmadd(a.x(), b.x(), fmadd(a.y(), b.y(), a.z() * b.z()));
+    }
+    friend SimdVec3 cross(const SimdVec3& a, const SimdVec3& b)
+    {
+        return SimdVec3{ fmsub(a.y(), b.z(), a.z() * b.y()), fmsub(a.z(), b.x(), a.x() * b.z()),
+                         fmsub(a.x(), b.y(), a.y() * b.x()) };
+    }
+
+    // ------------------------------------------------------
+    // Kinematics
+    // ------------------------------------------------------
+    simd_float mag2() const
+    {
+        return dot(*this, *this);
+    }
+    simd_float mag() const
+    {
+        return sqrt(mag2());
+    }
+    simd_float perp2() const
+    {
+        return fmadd(x(), x(), y() * y());
+    }
+    simd_float perp() const
+    {
+        return sqrt(perp2());
+    }
+    // Azimuth in [-pi, pi]
+    simd_float phi() const
+    {
+        return atan2(y(), x());
+    }
+    // Polar angle in [0, pi]
+    simd_float theta() const
+    {
+        return atan2(perp(), z());
+    }
+    // -ln tan(theta / 2) = sign(z) ln((|p| + |z|) / perp). As in ROOT, +-10e10
+    // along the z axis and 0 for the null vector
+    simd_float eta() const
+    {
+        const simd_float az = abs(z());
+        const simd_float pt = perp();
+        const simd_float zero{ 0.0f };
+        const simd_float axis = select(az > zero, simd_float{ 10e10f } ^ z().sign(), zero);
+        return select(pt > zero, log((mag() + az) / pt) ^ z().sign(), axis);
+    }
+    // Cosine of the angle to other
+    simd_float cosAngle(const SimdVec3& other) const
+    {
+        return dot(*this, other) / sqrt(mag2() * other.mag2());
+    }
+    SimdVec3 unit() const
+    {
+        return *this / mag();
+    }
+
+private:
+    simd_float data_[Size];
+};
+
+// ------------------------------------------------------
+// Lorentz vector
+// ------------------------------------------------------
+// (px, py, pz, E) in GeV, metric (+, -, -, -)
+class SimdLorentzVector
+{
+public:
+    static constexpr int Size{ 4 };
+
+    SimdLorentzVector()
+        : data_{ simd_float{ 0.0f }, simd_float{ 0.0f }, simd_float{ 0.0f }, simd_float{ 0.0f } }
+    {
+    }
+    SimdLorentzVector(const simd_float& px, const simd_float& py, const simd_float& pz, const simd_float& e)
+        : data_{ px, py, pz, e }
+    {
+    }
+    SimdLorentzVector(const SimdVec3& p, const simd_float& e) : data_{ p.x(), p.y(), p.z(), e } {}
+    // Particle of the given mass and momentum
+    static SimdLorentzVector fromMass(const SimdVec3& p, const simd_float& mass)
+    {
+        return SimdLorentzVector{ p, sqrt(fmadd(mass, mass, p.mag2())) };
+    }
+
+    simd_float& px()
+    {
+        return data_[0];
+    }
+    const simd_float& px() const
+    {
+        return data_[0];
+    }
+    simd_float& py()
+    {
+        return data_[1];
+    }
+    const simd_float& py() const
+    {
+        return data_[1];
+    }
+    simd_float& pz()
+    {
+        return data_[2];
+    }
+    const simd_float& pz() const
+    {
+        return data_[2];
+    }
+    simd_float& e()
+    {
+        return data_[3];
+    }
+    const simd_float& e() const
+    {
+        return data_[3];
+    }
+    simd_float& operator[](int k)
+    {
+        return data_[k];
+    }
+    const simd_float& operator[](int k) const
+    {
+        return data_[k];
+    }
+    SimdVec3 vect() const
+    {
+        return SimdVec3{ px(), py(), pz() };
+    }
+
+    // ------------------------------------------------------
+    // Load and Store
+    // ------------------------------------------------------
+    // (px, py, pz, E) of lane l at val_ptr + l * stride (AoS)
+    SimdLorentzVector& loadAoS(const float* val_ptr, int n = simd_float::SimdLen,
+                               std::size_t stride = Size)
+    {
+        Detail::loadAoS(data_, val_ptr, n, stride);
+        return *this;
+    }
+    void storeAoS(float* val_ptr, int n = simd_float::SimdLen, std::size_t stride = Size) const
+    {
+        Detail::storeAoS(data_, val_ptr, n, stride);
+    }
+    // Component k of all lanes at val_ptr + k * stride (SoA)
+    SimdLorentzVector& loadSoA(const float* val_ptr, std::size_t stride)
+    {
+        Detail::staticFor<Size>([&](auto k) { data_[k].load(val_ptr + k * stride); });
+        return *this;
+    }
+    void storeSoA(float* val_ptr, std::size_t stride) const
+    {
+        Detail::staticFor<Size>([&](auto k) { data_[k].store(val_ptr + k * stride); });
+    }
+
+    // ------------------------------------------------------
+    // Arithmetic
+    // ------------------------------------------------------
+    SimdLorentzVector& operator+=(const SimdLorentzVector& other)
+    {
+        Detail::staticFor<Size>([&](auto k) { data_[k] += other.data_[k]; });
+        return *this;
+    }
+    SimdLorentzVector& operator-=(const SimdLorentzVector& other)
+    {
+        Detail::staticFor<Size>([&](auto k) { data_[k] -= other.data_[k]; });
+        return *this;
+    }
+    SimdLorentzVector& operator*=(const simd_float& factor)
+    {
+        Detail::staticFor<Size>([&](auto k) { data_[k] *= factor; });
+        return *this;
+    }
+    friend SimdLorentzVector operator+(SimdLorentzVector a, const SimdLorentzVector& b)
+    {
+        return a += b;
+    }
+    friend SimdLorentzVector operator-(SimdLorentzVector a, const SimdLorentzVector& b)
+    {
+        return a -= b;
+    }
+    friend SimdLorentzVector operator*(SimdLorentzVector a, const simd_float& factor)
+    {
+        return a *= factor;
+    }
+    friend SimdLorentzVector operator*(const simd_float& factor, SimdLorentzVector a)
+    {
+        return a *= factor;
+    }
+
+    // Minkowski product E1 E2 - p1.p2
+    friend simd_float dot(const SimdLorentzVector& a, const SimdLorentzVector& b)
+    {
+        return fmsub(a.e(), b.e(), dot(a.vect(), b.vect()));
+    }
+
+    // ------------------------------------------------------
+    // Kinematics
+    // ------------------------------------------------------
+    simd_float mass2() const
+    {
+        return fmsub(e(), e(), vect().mag2());
+    }
+    // Zero for space-like vectors
+    simd_float mass() const
+    {
+        return sqrt(max(mass2(), simd_float{ 0.0f }));
+    }
+    simd_float p() const
+    {
+        return vect().mag();
+    }
+    simd_float pt() const
+    {
+        return vect().perp();
+    }
+    simd_float mt2() const
+    {
+        return fmsub(e(), e(), pz() * pz());
+    }
+    simd_float phi() const
+    {
+        return vect().phi();
+    }
+    simd_float theta() const
+    {
+        return vect().theta();
+    }
+    simd_float eta() const
+    {
+        return vect().eta();
+    }
+    // 0.5 ln((E + pz) / (E - pz))
+    simd_float rapidity() const
+    {
+        return simd_float{ 0.5f } * log((e() + pz()) / (e() - pz()));
+    }
+    // Velocity p / E of the rest frame
+    SimdVec3 boostVector() const
+    {
+        return vect() / e();
+    }
+
+    // Lorentz boost by the velocity b (|b| < 1)
+    SimdLorentzVector& boost(const SimdVec3& b)
+    {
+        const simd_float b2 = b.mag2();
+        const simd_float one{ 1.0f };
+        const simd_float gamma = one / sqrt(one - b2);
+        const simd_float bp = dot(b, vect());
+        // (gamma - 1) / b2 = gamma^2 / (gamma + 1), finite for b2 -> 0
+        const simd_float gamma2 = gamma * gamma / (gamma + one);
+        const simd_float factor = fmadd(gamma2, bp, gamma * e());
+        Detail::staticFor<3>([&](auto k) { data_[k] = fmadd(factor, b[k], data_[k]); });
+        e() = gamma * (e() + bp);
+        return *this;
+    }
+    SimdLorentzVector boostCopy(const SimdVec3& b) const
+    {
+        SimdLorentzVector copy{ *this };
+        return copy.boost(b);
+    }
+
+private:
+    simd_float data_[Size];
+};
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_LORENTZ_VECTOR_H
@@ -0,0 +1,129 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_MATH_H
+#define SIMD_MATH_H
+
+#include "../simd.h"
+
+// Elementary functions on simd_float, accurate to a few ulp over the ranges
+// met in track fitting. They use only the backend operations and constants
+// from simd_constant, so the same code runs on every backend.
+
+namespace KFP {
+namespace SIMD {
+
+namespace Detail {
+
+// Minimax series on [-pi/4, pi/4]
+__KFP_SIMD__INLINE simd_float sinSeries(const simd_float& x)
+{
+    const simd_float x2 = x * x;
+    simd_float y = simd_constant<float, 0xB9500D01>::get(); // -1.984126984e-4f
+    y = fmadd(y, x2, simd_constant<float, 0x3C088889>::get()); // 8.333333333e-3f
+    y = fmadd(y, x2, simd_constant<float, 0xBE2AAAAB>::get()); // -1.666666667e-1f
+    return fmadd(y, x2 * x, x);
+}
+__KFP_SIMD__INLINE simd_float cosSeries(const simd_float& x)
+{
+    const simd_float x2 = x * x;
+    simd_float y = simd_constant<float, 0x37D00D01>::get(); // 2.48015873e-5f
+    y = fmadd(y, x2, simd_constant<float, 0xBAB60B61>::get()); // -1.388888889e-3f
+    y = fmadd(y, x2, simd_constant<float, 0x3D2AAAAB>::get()); // 4.166666667e-2f
+    y = fmadd(y, x2, simd_constant<float, 0xBF000000>::get()); // -0.5f
+    return fmadd(y, x2, simd_constant<float, 0x3F800000>::get()); // 1.0f
+}
+
+// Minimax series on [-tan(pi/8), tan(pi/8)]
+__KFP_SIMD__INLINE simd_float atanSeries(const simd_float& x)
+{
+    const simd_float x2 = x * x;
+    simd_float y = simd_constant<float, 0x3DA4F0D1>::get(); // 8.05374449538e-2f
+    y = fmadd(y, x2, simd_constant<float, 0xBE0E1B85>::get()); // -1.38776856032e-1f
+    y = fmadd(y, x2, simd_constant<float, 0x3E4C925F>::get()); // 1.99777106478e-1f
+    y = fmadd(y, x2, simd_constant<float, 0xBEAAAA2A>::get()); // -3.33329491539e-1f
+    return fmadd(y, x2 * x, x);
+}
+// atan on [0, 1]: above tan(pi/8) as pi/4 + atan((x - 1) / (x + 1))
+__KFP_SIMD__INLINE simd_float atanUnit(const simd_float& x)
+{
+    const simd_float one = simd_constant<float, 0x3F800000>::get();
+    const simd_mask upper = x > simd_constant<float, 0x3ED413CD>::get(); // tan(pi/8)
+    const simd_float r = select(upper, (x - one) / (x + one), x);
+    const simd_float offset = select(upper, simd_constant<float, 0x3F490FDB>::get(), simd_float{ 0.0f }); // pi/4
+    return atanSeries(r) + offset;
+}
+
+} // namespace Detail
+
+// ------------------------------------------------------
+// Trigonometric functions
+// ------------------------------------------------------
+// Sine and cosine in one pass: x is reduced by n * pi/2 (Cody-Waite, three
+// parts, exact products for |x| < 1e4), the quadrant n & 3 swaps the series
+// and sets the signs.
+__KFP_SIMD__INLINE void sincos(const simd_float& x, simd_float& sinX, simd_float& cosX)
+{
+    const simd_float nPi2f = round(x * simd_constant<float, 0x3F22F983>::get()); // 2/pi
+    const simd_int q = simd_int{ nPi2f } & simd_int{ 3 };
+    simd_float r = fnmadd(simd_constant<float, 0x3FC90000>::get(), nPi2f, x); // 1.5703125f
+    r = fnmadd(simd_constant<float, 0x39FDA000>::get(), nPi2f, r); // 4.837512969970703e-4f
+    r = fnmadd(simd_constant<float, 0x33A22169>::get(), nPi2f, r); // 7.549790126404332e-8f
+
+    const simd_float sinS = Detail::sinSeries(r);
+    const simd_float cosS = Detail::cosSeries(r);
+    const simd_mask swap = (q & simd_int{ 1 }) == simd_int{ 1 };
+    const simd_float sinSign = simd_float::type_cast(q << 30).sign();
+    const simd_float cosSign = simd_float::type_cast((q + simd_int{ 1 }) << 30).sign();
+    sinX = sinSign ^ select(swap, cosS, sinS);
+    cosX = cosSign ^ select(swap, sinS, cosS);
+}
+__KFP_SIMD__INLINE simd_float sin(const simd_float& x)
+{
+    simd_float sinX, cosX;
+    sincos(x, sinX, cosX);
+    return sinX;
+}
+__KFP_SIMD__INLINE simd_float cos(const simd_float& x)
+{
+    simd_float sinX, cosX;
+    sincos(x, sinX, cosX);
+    return cosX;
+}
+
+// ------------------------------------------------------
+// Inverse trigonometric functions
+// ------------------------------------------------------
+// Arguments above 1 in magnitude use atan(x) = pi/2 - atan(1/x).
+__KFP_SIMD__INLINE simd_float atan(const simd_float& x)
+{
+    const simd_float ax = abs(x);
+    const simd_mask inverse = ax > simd_constant<float, 0x3F800000>::get();
+    const simd_float r = Detail::atanUnit(select(inverse, simd_float{ 1.0f } / ax, ax));
+    return select(inverse, simd_constant<float, 0x3FC90FDB>::get() - r, r) ^ x.sign(); // pi/2
+}
+// Angle of (x, y) in [-pi, pi], as std::atan2 for finite arguments: the
+// smaller of |x|, |y| over the larger one is reduced to the first octant and
+// the octant is restored from the signs and the swap.
+__KFP_SIMD__INLINE simd_float atan2(const simd_float& y, const simd_float& x)
+{
+    const simd_float ax = abs(x);
+    const simd_float ay = abs(y);
+    const simd_float num = min(ax, ay);
+    const simd_float den = max(ax, ay);
+    const simd_float zero{ 0.0f };
+    simd_float r = Detail::atanUnit(select(den == zero, zero, num / den));
+    r = select(ay > ax, simd_constant<float, 0x3FC90FDB>::get() - r, r); // pi/2
+    r = select(simd_int::type_cast(x) < simd_int{ 0 }, simd_constant<float, 0x40490FDB>::get() - r, r); // pi
+    return r ^ y.sign();
+}
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_MATH_H
@@ -0,0 +1,275 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_MATRIX_H
+#define SIMD_MATRIX_H
+
+#include "../simd.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Small fixed-size matrices with simd_float elements: every lane holds an
+// independent matrix, so one operation processes SimdLen candidates. All loops
+// run over compile-time bounds and are expanded with staticFor.
+
+namespace KFP {
+namespace SIMD {
+
+namespace Detail {
+
+template <typename F, int... Idx>
+__KFP_SIMD__INLINE void staticForImpl(F&& func, std::integer_sequence<int, Idx...>)
+{
+    (func(std::integral_constant<int, Idx>{}), ...);
+}
+
+// Calls func(std::integral_constant<int, I>{}) for I in [0, N), fully unrolled
+template <int N, typename F> __KFP_SIMD__INLINE void staticFor(F&& func)
+{
+    staticForImpl(func, std::make_integer_sequence<int, N>{});
+}
+
+// Element k of lane l at val_ptr[l * stride + k]: lanes from n on are zero on
+// load and left untouched on store
+template <std::size_t Size>
+__KFP_SIMD__INLINE void loadAoS(simd_float (&data)[Size], const float* val_ptr, int n, std::size_t stride)
+{
+    __KFP_SIMD__SPEC_ALIGN(__KFP_SIMD__Size_Float) float
+    buffer[Size * __KFP_SIMD__Len_Float]{}; // Helper data array
+    for (std::size_t iLane = 0; iLane < static_cast<std::size_t>(n); ++iLane) {
+        for (std::size_t k = 0; k < Size; ++k) {
+            buffer[k * simd_float::SimdLen + iLane] = val_ptr[iLane * stride + k];
+        }
+    }
+    staticFor<Size>([&](auto k) { data[k].load_a(buffer + k * simd_float::SimdLen); });
+}
+template <std::size_t Size>
+__KFP_SIMD__INLINE void storeAoS(const simd_float (&data)[Size], float* val_ptr, int n, std::size_t stride)
+{
+    __KFP_SIMD__SPEC_ALIGN(__KFP_SIMD__Size_Float) float
+    buffer[Size * __KFP_SIMD__Len_Float]{}; // Helper data array
+    staticFor<Size>([&](auto k) { data[k].store_a(buffer + k * simd_float::SimdLen); });
+    for (std::size_t iLane = 0; iLane < static_cast<std::size_t>(n); ++iLane) {
+        for (std::size_t k = 0; k < Size; ++k) {
+            val_ptr[iLane * stride + k] = buffer[k * simd_float::SimdLen + iLane];
+        }
+    }
+}
+
+} // namespace Detail
+
+// ------------------------------------------------------
+// Dense matrix
+// ------------------------------------------------------
+template <int Rows, int Cols> class SimdMatrix
+{
+public:
+    static_assert((Rows > 0) && (Cols > 0), "[Error] (KFP::SIMD::SimdMatrix): Invalid dimensions.");
+    static constexpr int NRows{ Rows };
+    static constexpr int NCols{ Cols };
+
+    // Zero matrix
+    SimdMatrix()
+    {
+        Detail::staticFor<Rows * Cols>([&](auto k) { data_[k] = simd_float{ 0.0f }; });
+    }
+    static SimdMatrix identity()
+    {
+        SimdMatrix result;
+        Detail::staticFor<(Rows < Cols ? Rows : Cols)>(
+            [&](auto i) { result(i, i) = simd_float{ 1.0f }; });
+        return result;
+    }
+
+    simd_float& operator()(int i, int j)
+    {
+        return data_[i * Cols + j];
+    }
+    const simd_float& operator()(int i, int j) const
+    {
+        return data_[i * Cols + j];
+    }
+
+    SimdMatrix<Cols, Rows> transpose() const
+    {
+        SimdMatrix<Cols, Rows> result;
+        Detail::staticFor<Rows>([&](auto i) {
+            Detail::staticFor<Cols>([&](auto j) { result(j, i) = (*this)(i, j); });
+        });
+        return result;
+    }
+
+private:
+    simd_float data_[static_cast<std::size_t>(Rows * Cols)];
+};
+
+template <int Rows, int Inner, int Cols>
+inline SimdMatrix<Rows, Cols> operator*(const SimdMatrix<Rows, Inner>& a,
+                                        const SimdMatrix<Inner, Cols>& b)
+{
+    SimdMatrix<Rows, Cols> result;
+    Detail::staticFor<Rows>([&](auto i) {
+        Detail::staticFor<Cols>([&](auto j) {
+            simd_float sum = a(i, 0) * b(0, j);
+            Detail::staticFor<Inner - 1>(
+                [&](auto k) { sum = fmadd(a(i, k + 1), b(k + 1, j), sum); });
+            result(i, j) = sum;
+        });
+    });
+    return result;
+}
+
+// ------------------------------------------------------
+// Symmetric matrix, packed lower triangle
+// ------------------------------------------------------
+// Element (i, j) with i >= j is stored at i*(i+1)/2 + j, the KFParticle
+// covariance layout (21 elements for N = 6, 36 for N = 8).
+template <int N> class SimdSymMatrix
+{
+public:
+    static_assert(N > 0, "[Error] (KFP::SIMD::SimdSymMatrix): Invalid dimension.");
+    static constexpr int Dim{ N };
+    static constexpr int Size{ N * (N + 1) / 2 };
+
+    static constexpr int index(int i, int j)
+    {
+        return (i >= j) ? (i * (i + 1) / 2 + j) : (j * (j + 1) / 2 + i);
+    }
+
+    // Zero matrix
+    SimdSymMatrix()
+    {
+        Detail::staticFor<Size>([&](auto k) { data_[k] = simd_float{ 0.0f }; });
+    }
+    static SimdSymMatrix identity()
+    {
+        SimdSymMatrix result;
+        Detail::staticFor<N>([&](auto i) { result(i, i) = simd_float{ 1.0f }; });
+        return result;
+    }
+
+    // ------------------------------------------------------
+    // Element access
+    // ------------------------------------------------------
+    simd_float& operator()(int i, int j)
+    {
+        return data_[index(i, j)];
+    }
+    const simd_float& operator()(int i, int j) const
+    {
+        return data_[index(i, j)];
+    }
+    // Packed element
+    simd_float& operator[](int k)
+    {
+        return data_[k];
+    }
+    const simd_float& operator[](int k) const
+    {
+        return data_[k];
+    }
+
+    // ------------------------------------------------------
+    // Load and Store
+    // ------------------------------------------------------
+    // Packed matrices of consecutive candidates, one every stride floats
+    // (AoS). Lanes from n on are zero on load and left untouched on store.
+    SimdSymMatrix& loadAoS(const float* val_ptr, int n = simd_float::SimdLen,
+                           std::size_t stride = Size)
+    {
+        Detail::loadAoS(data_, val_ptr, n, stride);
+        return *this;
+    }
+    void storeAoS(float* val_ptr, int n = simd_float::SimdLen, std::size_t stride = Size) const
+    {
+        Detail::storeAoS(data_, val_ptr, n, stride);
+    }
+    // Packed element k of all candidates at val_ptr + k * stride (SoA)
+    SimdSymMatrix& loadSoA(const float* val_ptr, std::size_t stride)
+    {
+        Detail::staticFor<Size>([&](auto k) { data_[k].load(val_ptr + k * stride); });
+        return *this;
+    }
+    void storeSoA(float* val_ptr, std::size_t stride) const
+    {
+        Detail::staticFor<Size>([&](auto k) { data_[k].store(val_ptr + k * stride); });
+    }
+
+    // ------------------------------------------------------
+    // Arithmetic
+    // ------------------------------------------------------
+    SimdSymMatrix& add(const SimdSymMatrix& other)
+    {
+        Detail::staticFor<Size>([&](auto k) { data_[k] += other.data_[k]; });
+        return *this;
+    }
+    SimdSymMatrix& scale(const simd_float& factor)
+    {
+        Detail::staticFor<Size>([&](auto k) { data_[k] *= factor; });
+        return *this;
+    }
+    friend SimdSymMatrix operator+(SimdSymMatrix a, const SimdSymMatrix& b)
+    {
+        return a.add(b);
+    }
+    friend SimdSymMatrix operator*(SimdSymMatrix a, const simd_float& factor)
+    {
+        return a.scale(factor);
+    }
+
+    // Dense product C * B
+    template <int Cols> SimdMatrix<N, Cols> multiply(const SimdMatrix<N, Cols>& b) const
+    {
+        SimdMatrix<N, Cols> result;
+        Detail::staticFor<N>([&](auto i) {
+            Detail::staticFor<Cols>([&](auto j) {
+                simd_float sum = (*this)(i, 0) * b(0, j);
+                Detail::staticFor<N - 1>(
+                    [&](auto k) { sum = fmadd((*this)(i, k + 1), b(k + 1, j), sum); });
+                result(i, j) = sum;
+            });
+        });
+        return result;
+    }
+
+    // F C F^T for an M x N matrix F. Only the lower triangle of the result is
+    // computed: M*N*N + M*(M+1)/2*N multiply-adds.
+    template <int M> SimdSymMatrix<M> similarity(const SimdMatrix<M, N>& F) const
+    {
+        // FC = F * C (M x N)
+        SimdMatrix<M, N> FC;
+        Detail::staticFor<M>([&](auto i) {
+            Detail::staticFor<N>([&](auto j) {
+                simd_float sum = F(i, 0) * (*this)(0, j);
+                Detail::staticFor<N - 1>(
+                    [&](auto k) { sum = fmadd(F(i, k + 1), (*this)(k + 1, j), sum); });
+                FC(i, j) = sum;
+            });
+        });
+        SimdSymMatrix<M> result;
+        Detail::staticFor<M>([&](auto i) {
+            Detail::staticFor<i + 1>([&](auto j) {
+                simd_float sum = FC(i, 0) * F(j, 0);
+                Detail::staticFor<N - 1>(
+                    [&](auto k) { sum = fmadd(FC(i, k + 1), F(j, k + 1), sum); });
+                result(i, j) = sum;
+            });
+        });
+        return result;
+    }
+
+private:
+    simd_float data_[static_cast<std::size_t>(Size)];
+};
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_MATRIX_H
@@ -265,6 +265,47 @@ template <> __KFP_SIMD__INLINE SimdDataF minus<SimdDataF>(const SimdDataF& a)
     return XORBits<SimdDataF>(a, type_cast<SimdDataF, SimdDataI>(getMask<MASK::MINUS>()));
 }
 
+template <>
+__KFP_SIMD__INLINE SimdDataF fmadd<SimdDataF>(const SimdDataF& a, const SimdDataF& b,
+                                              const SimdDataF& c)
+{
+#if defined(__FMA__)
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+template <>
+__KFP_SIMD__INLINE SimdDataF fmsub<SimdDataF>(const SimdDataF& a, const SimdDataF& b,
+                                              const SimdDataF& c)
+{
+#if defined(__FMA__)
+    return _mm_fmsub_ps(a, b, c);
+#else
+    return _mm_sub_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+template <>
+__KFP_SIMD__INLINE SimdDataF fnmadd<SimdDataF>(const SimdDataF& a, const SimdDataF& b,
+                                               const SimdDataF& c)
+{
+#if defined(__FMA__)
+    return _mm_fnmadd_ps(a, b, c);
+#else
+    return _mm_sub_ps(c, _mm_mul_ps(a, b));
+#endif
+}
+template <>
+__KFP_SIMD__INLINE SimdDataF fnmsub<SimdDataF>(const SimdDataF& a, const SimdDataF& b,
+                                               const SimdDataF& c)
+{
+#if defined(__FMA__)
+    return _mm_fnmsub_ps(a, b, c);
+#else
+    return minus<SimdDataF>(_mm_add_ps(_mm_mul_ps(a, b), c));
+#endif
+}
+
 template <>
 __KFP_SIMD__INLINE SimdDataF min<SimdDataF>(const SimdDataF& a, const SimdDataF& b)
 {
@@ -14,6 +14,7 @@ Emails: mithran@fias.uni-frankfurt.de
 #include "simd_sse_type.h"
 
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 
 namespace KFP {
@@ -23,27 +24,18 @@ namespace Detail {
 
 enum class MASK { ABS, MINUS, TRUE, INF };
 
+// Masks are loaded from the shared aligned constant tables
+template <MASK mask> struct MaskBits;
+template <> struct MaskBits<MASK::ABS> { static constexpr std::uint32_t value{ 0x7FFFFFFF }; };
+template <> struct MaskBits<MASK::MINUS> { static constexpr std::uint32_t value{ 0x80000000 }; };
+template <> struct MaskBits<MASK::TRUE> { static constexpr std::uint32_t value{ 0xFFFFFFFF }; };
+template <> struct MaskBits<MASK::INF> { static constexpr std::uint32_t value{ 0x7F800000 }; };
+
 template <MASK mask>
-const __KFP_SIMD__INLINE SimdDataI getMask()
+__KFP_SIMD__INLINE SimdDataI getMask()
 {
-  switch (mask) {
-  case MASK::ABS:
-//     {
-//         __m128i minus1;
-// #if _MSC_VER && !__INTEL_COMPILER
-//         minus1 = _mm_setzero_si128();
-// #endif
-//         minus1 = _mm_cmpeq_epi32(minus1, minus1);
-//         return (_mm_srli_epi32(minus1, 1));
-//     }
-    return _mm_set1_epi32(0x7FFFFFFF);
-  case MASK::MINUS:
-    return _mm_set1_epi32(0x80000000);
-  case MASK::TRUE:
-    return _mm_set1_epi32(-1);
-  case MASK::INF:
-    return _mm_set1_epi32(0x7F800000);
-  }
+  return _mm_load_si128(reinterpret_cast<const SimdDataI*>(
+      ConstantPool<MaskBits<mask>::value, __KFP_SIMD__Len_Int, __KFP_SIMD__Size_Int>::data));
 }
 
 // ------------------------------------------------------
@@ -241,11 +233,11 @@ __KFP_SIMD__INLINE ValueDataI extract<ValueDataI, SimdDataI>(int index,
 template <>
 __KFP_SIMD__INLINE void insert<SimdDataI, ValueDataI>(SimdDataI& val_simd, int index,
                                           ValueDataI val) {
-    __KFP_SIMD__SPEC_ALIGN(__KFP_SIMD__Size_Int) ValueDataI
-    data[__KFP_SIMD__Len_Int]{}; // Helper data array
-    store_a<SimdDataI, ValueDataI>(val_simd, data);
-    data[index] = val;
-    val_simd = load_a<SimdDataI, ValueDataI>(data);
+    // Blend the broadcast value into the lane selected by comparing against the
+    // lane numbers. Stays in registers on every SSE tier.
+    const SimdDataI mask = equal<SimdDataI>(_mm_setr_epi32(0, 1, 2, 3),
+                                            constant<SimdDataI, ValueDataI>(index));
+    val_simd = select<SimdDataI>(mask, constant<SimdDataI, ValueDataI>(val), val_simd);
 }
 template <>
 __KFP_SIMD__INLINE SimdDataI shiftLLanes<SimdDataI>(int n, const SimdDataI &val_simd) {
@@ -298,14 +290,11 @@ template <> __KFP_SIMD__INLINE SimdDataI rotate<SimdDataI>(int n, const SimdData
   case 0:
     return val_simd;
   case 1:
-    return ORBits<SimdDataI>(shiftLLanes<SimdDataI>(1, val_simd),
-                             shiftRLanes<SimdDataI>(3, val_simd));
+    return _mm_shuffle_epi32(val_simd, _MM_SHUFFLE(0, 3, 2, 1));
   case 2:
-    return ORBits<SimdDataI>(shiftLLanes<SimdDataI>(2, val_simd),
-                             shiftRLanes<SimdDataI>(2, val_simd));
+    return _mm_shuffle_epi32(val_simd, _MM_SHUFFLE(1, 0, 3, 2));
   case 3:
-    return ORBits<SimdDataI>(shiftLLanes<SimdDataI>(3, val_simd),
-                             shiftRLanes<SimdDataI>(1, val_simd));
+    return _mm_shuffle_epi32(val_simd, _MM_SHUFFLE(2, 1, 0, 3));
   }
     return constant<SimdDataI, ValueDataI>(0);
 #endif
@@ -328,37 +317,50 @@ __KFP_SIMD__INLINE SimdDataI multiply<SimdDataI>(const SimdDataI &a, const SimdD
 #if defined(__KFP_SIMD__SSE4_1) // SSE4.1
   return _mm_mullo_epi32(a, b);
 #else
-
-    __KFP_SIMD__SPEC_ALIGN(__KFP_SIMD__Size_Int) ValueDataI
-    data1[__KFP_SIMD__Len_Int]{}; // Helper data array
-    store_a<SimdDataI, ValueDataI>(a, data1);
-
-    __KFP_SIMD__SPEC_ALIGN(__KFP_SIMD__Size_Int) ValueDataI
-    data2[__KFP_SIMD__Len_Int]{}; // Helper data array
-    store_a<SimdDataI, ValueDataI>(b, data2);
-
-    __KFP_SIMD__SPEC_ALIGN(__KFP_SIMD__Size_Int) const ValueDataI
-    data[__KFP_SIMD__Len_Int]{data1[0] * data2[0], data1[1] * data2[1],
-                                data1[2] * data2[2], data1[3] * data2[3]};
-  return load_a<SimdDataI, ValueDataI>(data);
+  // SSE2: _mm_mul_epu32 multiplies the even lanes into 64-bit products. The
+  // low 32 bits are the same for signed and unsigned operands, so multiply the
+  // even and the odd lanes separately and interleave the low halves again.
+  const SimdDataI prod02 = _mm_mul_epu32(a, b);
+  const SimdDataI prod13 = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(prod02, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(prod13, _MM_SHUFFLE(0, 0, 2, 0)));
 #endif
 }
 template <>
 __KFP_SIMD__INLINE SimdDataI divide<SimdDataI>(const SimdDataI &a, const SimdDataI &b) {
-    __KFP_SIMD__SPEC_ALIGN(__KFP_SIMD__Size_Int) ValueDataI
-    data1[__KFP_SIMD__Len_Int]{}; // Helper data array
-    store_a<SimdDataI, ValueDataI>(a, data1);
-    __KFP_SIMD__SPEC_ALIGN(__KFP_SIMD__Size_Int) ValueDataI
-    data2[__KFP_SIMD__Len_Int]{}; // Helper data array
-    store_a<SimdDataI, ValueDataI>(b, data2);
-    __KFP_SIMD__SPEC_ALIGN(__KFP_SIMD__Size_Int) const ValueDataI
-    data[__KFP_SIMD__Len_Int]{data1[0] / data2[0], data1[1] / data2[1],
-                            data1[2] / data2[2], data1[3] / data2[3]};
-    return load_a<SimdDataI, ValueDataI>(data);
+  // There is no integer division in SSE. Every int32 is exact in double and the
+  // truncated double quotient equals the integer quotient, so divide two lanes
+  // at a time in double precision.
+  const SimdDataI a_hi = _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2));
+  const SimdDataI b_hi = _mm_shuffle_epi32(b, _MM_SHUFFLE(1, 0, 3, 2));
+  const __m128d quot_lo = _mm_div_pd(_mm_cvtepi32_pd(a), _mm_cvtepi32_pd(b));
+  const __m128d quot_hi = _mm_div_pd(_mm_cvtepi32_pd(a_hi), _mm_cvtepi32_pd(b_hi));
+  return _mm_unpacklo_epi64(_mm_cvttpd_epi32(quot_lo), _mm_cvttpd_epi32(quot_hi));
 }
 template <> __KFP_SIMD__INLINE SimdDataI minus<SimdDataI>(const SimdDataI &a) {
   return substract<SimdDataI>(_mm_setzero_si128(), a);
 }
+// No fused integer multiply-add: composed from multiply and add
+template <>
+__KFP_SIMD__INLINE SimdDataI fmadd<SimdDataI>(const SimdDataI &a, const SimdDataI &b,
+                                              const SimdDataI &c) {
+  return add<SimdDataI>(multiply<SimdDataI>(a, b), c);
+}
+template <>
+__KFP_SIMD__INLINE SimdDataI fmsub<SimdDataI>(const SimdDataI &a, const SimdDataI &b,
+                                              const SimdDataI &c) {
+  return substract<SimdDataI>(multiply<SimdDataI>(a, b), c);
+}
+template <>
+__KFP_SIMD__INLINE SimdDataI fnmadd<SimdDataI>(const SimdDataI &a, const SimdDataI &b,
+                                               const SimdDataI &c) {
+  return substract<SimdDataI>(c, multiply<SimdDataI>(a, b));
+}
+template <>
+__KFP_SIMD__INLINE SimdDataI fnmsub<SimdDataI>(const SimdDataI &a, const SimdDataI &b,
+                                               const SimdDataI &c) {
+  return minus<SimdDataI>(fmadd<SimdDataI>(a, b, c));
+}
 
 template <>
 __KFP_SIMD__INLINE SimdDataI min<SimdDataI>(const SimdDataI &a, const SimdDataI &b) {
@@ -396,7 +398,9 @@ template <> __KFP_SIMD__INLINE SimdDataI abs<SimdDataI>(const SimdDataI &a) {
 #if defined(__KFP_SIMD__SSSE3) // SSSE3
   return _mm_abs_epi32(a);
 #else
-  return ANDBits<SimdDataI>(a, getMask<MASK::ABS>());
+  // Two's complement: (a ^ s) - s with s = a >> 31 (all ones for negative a)
+  const SimdDataI sign_bits = _mm_srai_epi32(a, 31);
+  return substract<SimdDataI>(XORBits<SimdDataI>(a, sign_bits), sign_bits);
 #endif
 }
 template <> __KFP_SIMD__INLINE SimdDataI log<SimdDataI>(const SimdDataI &a) {
@@ -268,11 +268,15 @@ __KFP_SIMD__INLINE simd_float select(const simd_mask& mask, const simd_float& a,
 
 template <typename F> __KFP_SIMD__INLINE simd_float apply(const simd_float& a, const F& func)
 {
-    __KFP_SIMD__SPEC_ALIGN(__KFP_SIMD__Size_Float) simd_float::value_type
-    data[__KFP_SIMD__Len_Float]{}; // Helper data array
-    a.store_a(data);
-    return simd_float{ _mm_setr_ps(func(data[0]), func(data[1]), func(data[2]),
-                              func(data[3])) };
+    if constexpr (Detail::isSimdCallable<F, simd_float>::value) {
+        return simd_float{ func(a) };
+    } else {
+        __KFP_SIMD__SPEC_ALIGN(__KFP_SIMD__Size_Float) simd_float::value_type
+        data[__KFP_SIMD__Len_Float]{}; // Helper data array
+        a.store_a(data);
+        return simd_float{ _mm_setr_ps(func(data[0]), func(data[1]), func(data[2]),
+                                  func(data[3])) };
+    }
 }
 
 __KFP_SIMD__INLINE simd_float round(const simd_float& a)
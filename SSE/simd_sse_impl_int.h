@@ -268,11 +268,15 @@ __KFP_SIMD__INLINE simd_int select(const simd_mask& mask, const simd_int& a, con
 }
 template <typename F> __KFP_SIMD__INLINE simd_int apply(const simd_int& a, const F& func)
 {
-    __KFP_SIMD__SPEC_ALIGN(__KFP_SIMD__Size_Int) simd_int::value_type
-    data[__KFP_SIMD__Len_Int]{}; // Helper data array
-    a.store(data);
-    return simd_int{ _mm_setr_epi32(func(data[0]), func(data[1]), func(data[2]),
-                              func(data[3])) };
+    if constexpr (Detail::isSimdCallable<F, simd_int>::value) {
+        return simd_int{ func(a) };
+    } else {
+        __KFP_SIMD__SPEC_ALIGN(__KFP_SIMD__Size_Int) simd_int::value_type
+        data[__KFP_SIMD__Len_Int]{}; // Helper data array
+        a.store(data);
+        return simd_int{ _mm_setr_epi32(func(data[0]), func(data[1]), func(data[2]),
+                                  func(data[3])) };
+    }
 }
 
 } // namespace SIMD
@@ -14,180 +14,332 @@ Emails: mithran@fias.uni-frankfurt.de
 
 #include <iostream>
 #include <cmath>
+#include <cstring>
+#include <limits>
 
 namespace KFP {
 namespace SIMD {
 
 namespace Detail {
 
-template <typename T1, typename T2> T1 type_cast(const T2& val_simd)
+// ------------------------------------------------------
+// General
+// ------------------------------------------------------
+// Reinterpret the bits of one scalar as another of the same size
+// (equivalent of _mm_castps_si128 and friends).
+template <typename T1, typename T2> inline T1 type_cast(const T2& val_simd)
 {
-    return type_cast<T1>(val_simd);
+    static_assert(sizeof(T1) == sizeof(T2),
+                  "[Error] (Detail::type_cast): Types of different size can not be reinterpreted.");
+    T1 result;
+    std::memcpy(&result, &val_simd, sizeof(T1));
+    return result;
 }
 
-template <typename T1, typename T2> T1 value_cast(const T2& val_simd)
+template <typename T1, typename T2> inline T1 value_cast(const T2& val_simd)
 {
     return static_cast<T1>(val_simd);
 }
-template <typename T1, typename T2> T1 sign(const T2& a)
-{
-    return std::signbit(a) ? T1{-1} : T1{1};
-}
 
-template <typename T1, typename T2> T1 constant(const T2 val)
+template <typename T1, typename T2> inline T1 constant(T2 val)
 {
     return static_cast<T1>(val);
 }
 
-template <typename T1, typename T2> inline T1 rotated(int amount, const T2& val)
+// ------------------------------------------------------
+// Load and Store
+// ------------------------------------------------------
+template <typename T1, typename T2> inline T1 load(const T2* val_ptr)
+{
+    return static_cast<T1>(val_ptr[0]);
+}
+template <typename T1, typename T2> inline T1 load_a(const T2* val_ptr)
 {
-    return val;
+    return static_cast<T1>(val_ptr[0]);
+}
+template <typename T1, typename T2> inline void store(const T1& val_simd, T2* val_ptr)
+{
+    val_ptr[0] = static_cast<T2>(val_simd);
+}
+template <typename T1, typename T2> inline void store_a(const T1& val_simd, T2* val_ptr)
+{
+    val_ptr[0] = static_cast<T2>(val_simd);
 }
 
-template <typename T> void print(std::ostream& stream, const T& val_simd)
+// ------------------------------------------------------
+// Logical bitwise
+// ------------------------------------------------------
+template <typename T1, typename T2, typename T3>
+inline T1 ANDBits(const T2& a, const T3& b)
 {
-    stream << "[" << val_simd << "]";
+    return (a & b);
+}
+template <typename T1, typename T2, typename T3>
+inline T1 ORBits(const T2& a, const T3& b)
+{
+    return (a | b);
+}
+template <typename T1, typename T2, typename T3>
+inline T1 XORBits(const T2& a, const T3& b)
+{
+    return (a ^ b);
+}
+template <typename T1, typename T2> inline T1 NOTBits(const T2& a)
+{
+    return ~a;
 }
 
-template <typename T1, typename T2> T1 minus(const T2& a)
+// Floating point bitwise operations go through the integer representation
+template <> inline SimdDataF ANDBits<SimdDataF>(const SimdDataF& a, const SimdDataF& b)
 {
-    return -a;
+    return type_cast<SimdDataF, SimdDataI>(type_cast<SimdDataI, SimdDataF>(a) &
+                                           type_cast<SimdDataI, SimdDataF>(b));
+}
+template <> inline SimdDataF ORBits<SimdDataF>(const SimdDataF& a, const SimdDataF& b)
+{
+    return type_cast<SimdDataF, SimdDataI>(type_cast<SimdDataI, SimdDataF>(a) |
+                                           type_cast<SimdDataI, SimdDataF>(b));
+}
+template <> inline SimdDataF XORBits<SimdDataF>(const SimdDataF& a, const SimdDataF& b)
+{
+    return type_cast<SimdDataF, SimdDataI>(type_cast<SimdDataI, SimdDataF>(a) ^
+                                           type_cast<SimdDataI, SimdDataF>(b));
+}
+template <> inline SimdDataF NOTBits<SimdDataF>(const SimdDataF& a)
+{
+    return type_cast<SimdDataF, SimdDataI>(~type_cast<SimdDataI, SimdDataF>(a));
 }
 
+// ------------------------------------------------------
+// Comparison
+// ------------------------------------------------------
+// Results are 0 or 1 and converted to a lane mask by SimdMaskBase.
 template <typename T1, typename T2, typename T3>
-T1 add(const T2& a, const T3& b)
+inline T1 equal(const T2& a, const T3& b)
 {
-    return (a + b);
+    return static_cast<T1>(a == b);
 }
-
 template <typename T1, typename T2, typename T3>
-T1 substract(const T2& a, const T3& b)
+inline T1 notEqual(const T2& a, const T3& b)
 {
-    return (a - b);
+    return static_cast<T1>(a != b);
 }
-
 template <typename T1, typename T2, typename T3>
-T1 multiply(const T2& a, const T3& b)
+inline T1 lessThan(const T2& a, const T3& b)
 {
-    return (a * b);
+    return static_cast<T1>(a < b);
 }
-
 template <typename T1, typename T2, typename T3>
-T1 divide(const T2& a, const T3& b)
+inline T1 lessThanEqual(const T2& a, const T3& b)
 {
-    return (a / b);
+    return static_cast<T1>(a <= b);
 }
-
 template <typename T1, typename T2, typename T3>
-T1 min(const T2& a, const T3& b)
+inline T1 greaterThan(const T2& a, const T3& b)
 {
-    return std::min(a, b);
+    return static_cast<T1>(a > b);
 }
-
 template <typename T1, typename T2, typename T3>
-T1 max(const T2& a, const T3& b)
+inline T1 greaterThanEqual(const T2& a, const T3& b)
 {
-    return std::max(a, b);
+    return static_cast<T1>(a >= b);
 }
 
-template <typename T1, typename T2> T1 sqrt(const T2& a)
+// ------------------------------------------------------
+// Manipulate bits
+// ------------------------------------------------------
+template <typename T1, typename T2> inline T1 shiftLBits(const T2& a, int b)
 {
-    return std::sqrt(a);
+    return (a << b);
 }
-
-/* Reciprocal( inverse) Square Root */
-template <typename T1, typename T2> T1 rsqrt(const T2& a)
+template <typename T1, typename T2> inline T1 shiftRBits(const T2& a, int b)
 {
-    return T1{1}/std::sqrt(a) ;
+    return (a >> b);
 }
 
-template <typename T1, typename T2> T1 abs(const T2& a)
+// ------------------------------------------------------
+// Logical lanewise
+// ------------------------------------------------------
+template <typename T1, typename T2, typename T3>
+inline T1 ANDLanes(const T2& a, const T3& b)
 {
-    return std::abs(a) ;
+    return (a & b);
 }
-
-template <typename T1, typename T2> T1 log(const T2& a)
+template <typename T1, typename T2, typename T3>
+inline T1 ORLanes(const T2& a, const T3& b)
 {
-    return std::log(a) ;
+    return (a | b);
 }
-
-template <typename T1, typename T2> T1 pow(const T2& a, int exp)
+template <typename T1, typename T2, typename T3>
+inline T1 XORLanes(const T2& a, const T3& b)
 {
-    return std::pow(a, exp) ;
+    return (a ^ b);
+}
+template <typename T1, typename T2> inline T1 NOTLanes(const T2& a)
+{
+    return ~a;
 }
 
-/* Logical */
-template <typename T1, typename T2>
-T1 opShiftLeft(const T2& a, int b)
+// ------------------------------------------------------
+// Manipulate lanes
+// ------------------------------------------------------
+template <typename T1, typename T2, typename T3, typename T4>
+inline T1 select(const T2& mask, const T3& a, const T4& b)
 {
-    return (a << b) ;
+    return mask ? a : b;
 }
-template <typename T1, typename T2>
-T1 opShiftRight(const T2& a, int b)
+template <typename T1, typename T2> inline T1 extract(int, const T2& val_simd)
 {
-    return (a >> b) ;
+    return val_simd;
 }
-template <typename T1, typename T2, typename T3>
-T1 opANDbitwise(const T2& a, const T3& b)
+template <typename T1, typename T2> inline void insert(T1& val_simd, int index, T2 val)
 {
-    return (a&b) ;
+    if (index == 0) {
+        val_simd = val;
+    }
 }
+// A single lane is either kept (n == 0) or shifted out completely.
+template <typename T1, typename T2> inline T1 shiftLLanes(int n, const T2& val_simd)
+{
+    return (n == 0) ? val_simd : T1{ 0 };
+}
+template <typename T1, typename T2> inline T1 shiftRLanes(int n, const T2& val_simd)
+{
+    return (n == 0) ? val_simd : T1{ 0 };
+}
+template <typename T1, typename T2> inline T1 rotate(int, const T2& val_simd)
+{
+    return val_simd;
+}
+
+// ------------------------------------------------------
+// Basic Arithmetic
+// ------------------------------------------------------
 template <typename T1, typename T2, typename T3>
-T1 opORbitwise(const T2& a, const T3& b)
+inline T1 add(const T2& a, const T3& b)
 {
-    return (a|b) ;
+    return (a + b);
 }
 template <typename T1, typename T2, typename T3>
-T1 opXORbitwise(const T2& a, const T3& b)
+inline T1 substract(const T2& a, const T3& b)
 {
-    return (a^b) ;
+    return (a - b);
 }
 template <typename T1, typename T2, typename T3>
-T1 opAND(const T2& a, const T3& b)
+inline T1 multiply(const T2& a, const T3& b)
 {
-    return (a&&b) ;
+    return (a * b);
 }
 template <typename T1, typename T2, typename T3>
-T1 opOR(const T2& a, const T3& b)
+inline T1 divide(const T2& a, const T3& b)
 {
-    return (a||b) ;
+    return (a / b);
+}
+template <typename T1, typename T2> inline T1 minus(const T2& a)
+{
+    return -a;
 }
 
-/* Comparison */
-template <typename T1, typename T2, typename T3>
-T1 opLessThan(const T2& a, const T3& b)
+template <typename T1, typename T2, typename T3, typename T4>
+inline T1 fmadd(const T2& a, const T3& b, const T4& c)
+{
+    return (a * b + c);
+}
+template <typename T1, typename T2, typename T3, typename T4>
+inline T1 fmsub(const T2& a, const T3& b, const T4& c)
+{
+    return (a * b - c);
+}
+template <typename T1, typename T2, typename T3, typename T4>
+inline T1 fnmadd(const T2& a, const T3& b, const T4& c)
+{
+    return (c - a * b);
+}
+template <typename T1, typename T2, typename T3, typename T4>
+inline T1 fnmsub(const T2& a, const T3& b, const T4& c)
+{
+    return -(a * b + c);
+}
+// Single rounding only where std::fma is a hardware instruction; the software
+// fallback of std::fma is far slower than a multiply and an add.
+#if defined(FP_FAST_FMAF)
+template <>
+inline SimdDataF fmadd<SimdDataF>(const SimdDataF& a, const SimdDataF& b, const SimdDataF& c)
+{
+    return std::fma(a, b, c);
+}
+template <>
+inline SimdDataF fmsub<SimdDataF>(const SimdDataF& a, const SimdDataF& b, const SimdDataF& c)
+{
+    return std::fma(a, b, -c);
+}
+template <>
+inline SimdDataF fnmadd<SimdDataF>(const SimdDataF& a, const SimdDataF& b, const SimdDataF& c)
+{
+    return std::fma(-a, b, c);
+}
+template <>
+inline SimdDataF fnmsub<SimdDataF>(const SimdDataF& a, const SimdDataF& b, const SimdDataF& c)
 {
-    return static_cast<T1>(a < b) ;
+    return -std::fma(a, b, c);
 }
+#endif
 
+// Same operand order as minps/maxps: the second operand is returned when
+// the comparison fails, e.g. when either value is NaN.
 template <typename T1, typename T2, typename T3>
-T1 opLessThanEqual(const T2& a, const T3& b)
+inline T1 min(const T2& a, const T3& b)
 {
-    return static_cast<T1>(a <= b) ;
+    return (a < b) ? a : b;
 }
-
 template <typename T1, typename T2, typename T3>
-T1 opGreaterThan(const T2& a, const T3& b)
+inline T1 max(const T2& a, const T3& b)
 {
-    return static_cast<T1>(a > b) ;
+    return (a > b) ? a : b;
 }
 
-template <typename T1, typename T2, typename T3>
-T1 opGreaterThanEqual(const T2& a, const T3& b)
+template <typename T1, typename T2> inline T1 sqrt(const T2& a)
 {
-    return static_cast<T1>(a >= b) ;
+    return std::sqrt(a);
+}
+/* Reciprocal( inverse) Square Root */
+template <typename T1, typename T2> inline T1 rsqrt(const T2& a)
+{
+    return T1{1}/std::sqrt(a) ;
+}
+// Integer roots are computed in single precision and rounded to nearest,
+// like _mm_cvtps_epi32(_mm_sqrt_ps(_mm_cvtepi32_ps(a))).
+template <> inline SimdDataI sqrt<SimdDataI>(const SimdDataI& a)
+{
+    return static_cast<SimdDataI>(std::nearbyint(std::sqrt(static_cast<float>(a))));
+}
+template <> inline SimdDataI rsqrt<SimdDataI>(const SimdDataI& a)
+{
+    return static_cast<SimdDataI>(std::nearbyint(1.0f / std::sqrt(static_cast<float>(a))));
 }
 
-template <typename T1, typename T2, typename T3>
-T1 opEqual(const T2& a, const T3& b)
+template <typename T1, typename T2> inline T1 abs(const T2& a)
 {
-    return static_cast<T1>(a == b) ;
+    return std::abs(a) ;
+}
+template <typename T1, typename T2> inline T1 log(const T2& a)
+{
+    return std::log(a) ;
+}
+template <typename T1, typename T2> inline T1 pow(const T2& a, int exp)
+{
+    return std::pow(a, exp) ;
 }
 
-template <typename T1, typename T2, typename T3>
-T1 opNotEqual(const T2& a, const T3& b)
+// Keep only the sign bit, as the SSE and AVX implementations do.
+template <typename T1, typename T2> inline T1 sign(const T2& a)
+{
+    return ANDBits<T1>(a, type_cast<T1, SimdDataI>(std::numeric_limits<SimdDataI>::min()));
+}
+
+template <typename T> inline void print(std::ostream& stream, const T& val_simd)
 {
-    return static_cast<T1>(a != b) ;
+    stream << "[" << val_simd << "]";
 }
 
 } // namespace Detail
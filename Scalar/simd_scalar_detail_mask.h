@@ -27,20 +27,15 @@ inline void print<simd_mask>(std::ostream& stream, const simd_mask& class_simd)
     stream << std::boolalpha << "[" << static_cast<bool>(class_simd.maski()) << "]" << std::noboolalpha;
 }
 
-template <> inline SimdDataI opNOT<SimdDataI>(const SimdDataI& a)
-{
-    return static_cast<SimdDataI>(a + 1);
-}
-
 template <>
-inline bool opEqual<bool, SimdDataI, SimdDataI>(const SimdDataI& a,
+inline bool equal<bool, SimdDataI, SimdDataI>(const SimdDataI& a,
                                               const SimdDataI& b)
 {
     return (a == b);
 }
 
 template <>
-inline bool opNotEqual<bool, SimdDataI, SimdDataI>(const SimdDataI& a,
+inline bool notEqual<bool, SimdDataI, SimdDataI>(const SimdDataI& a,
                                                  const SimdDataI& b)
 {
     return (a != b);
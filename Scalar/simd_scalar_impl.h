@@ -14,6 +14,8 @@ Emails: mithran@fias.uni-frankfurt.de
 #include "simd_scalar_detail.h"
 
 #include <cassert>
+#include <cstdlib>
+#include <string>
 
 namespace KFP {
 namespace SIMD {
@@ -68,12 +70,8 @@ SimdClassBase<ValueType, tag>& SimdClassBase<ValueType, tag>::load_a(const Value
 template<typename ValueType, Tag tag>
 SimdClassBase<ValueType, tag>& SimdClassBase<ValueType, tag>::load_partial(int index, const ValueType* p)
 {
-    assert((index > 0) && ("[Error] (load_partial): invalid index (" +
-                           std::to_string(index) + ") given. Not postive.")
-                              .data());
-    if (index < 1)
-        return *this;
-    data_.simd_ = *p;
+    // Same as SSE and AVX: loading zero elements clears the vector
+    data_.simd_ = (index < 1) ? ValueType{ 0 } : *p;
     return *this;
 }
 
@@ -95,9 +93,6 @@ void SimdClassBase<ValueType, tag>::store_stream(ValueType* p) const
 template<typename ValueType, Tag tag>
 void SimdClassBase<ValueType, tag>::store_partial(int index, ValueType* p) const
 {
-    assert((index > 0) && ("[Error] (store_partial): invalid index (" +
-                           std::to_string(index) + ") given. Not positive.")
-                              .data());
     if (index < 1)
         return;
     *p = data_.simd_;
@@ -106,13 +101,13 @@ void SimdClassBase<ValueType, tag>::store_partial(int index, ValueType* p) const
 template<typename ValueType, Tag tag>
 SimdClassBase<ValueType, tag>& SimdClassBase<ValueType, tag>::gather(const ValueType* p, const SimdClassBase<int, tag>& indices)
 {
-    data_.simd_ = p[indices[0]];
+    data_.simd_ = p[indices.simd()];
     return *this;
 }
 template<typename ValueType, Tag tag>
 void SimdClassBase<ValueType, tag>::scatter(ValueType* p, const SimdClassBase<int, tag>& indices) const
 {
-    p[indices[0]] = data_.simd_;
+    p[indices.simd()] = data_.simd_;
 }
 
 template<typename ValueType, Tag tag>
@@ -173,26 +168,74 @@ SimdClassBase<ValueType, tag> SimdClassBase<ValueType, tag>::cutoffCopy(int inde
                             std::to_string(index) + ") given. Negative")
                                .data());
     if (index == 0){
-        return SimdClassBase<ValueType, tag>{ 0 };
+        return SimdClassBase<ValueType, tag>{ ValueType{ 0 } };
     }
     return *this;
 }
-// TODO: add shifts and rotates
+template<typename ValueType, Tag tag>
+SimdClassBase<ValueType, tag>& SimdClassBase<ValueType, tag>::shiftLeft(int n)
+{
+    data_.simd_ = Detail::shiftLLanes<simd_type>(n, data_.simd_);
+    return *this;
+}
+template<typename ValueType, Tag tag>
+SimdClassBase<ValueType, tag> SimdClassBase<ValueType, tag>::shiftLeftCopy(int n) const
+{
+    return SimdClassBase<ValueType, tag>{ Detail::shiftLLanes<simd_type>(n, data_.simd_) };
+}
+template<typename ValueType, Tag tag>
+SimdClassBase<ValueType, tag>& SimdClassBase<ValueType, tag>::shiftRight(int n)
+{
+    data_.simd_ = Detail::shiftRLanes<simd_type>(n, data_.simd_);
+    return *this;
+}
+template<typename ValueType, Tag tag>
+SimdClassBase<ValueType, tag> SimdClassBase<ValueType, tag>::shiftRightCopy(int n) const
+{
+    return SimdClassBase<ValueType, tag>{ Detail::shiftRLanes<simd_type>(n, data_.simd_) };
+}
+template<typename ValueType, Tag tag>
+SimdClassBase<ValueType, tag>& SimdClassBase<ValueType, tag>::rotate(int n)
+{
+    data_.simd_ = Detail::rotate<simd_type>(n, data_.simd_);
+    return *this;
+}
+template<typename ValueType, Tag tag>
+SimdClassBase<ValueType, tag> SimdClassBase<ValueType, tag>::rotateCopy(int n) const
+{
+    return SimdClassBase<ValueType, tag>{ Detail::rotate<simd_type>(n, data_.simd_) };
+}
 
-template <typename T>
-inline T select(const simd_mask& mask, const T& a, const T& b)
+inline simd_float select(const simd_mask& mask, const simd_float& a, const simd_float& b)
+{
+    return simd_float{ Detail::select<simd_float::simd_type>(mask.maski(), a.simd(), b.simd()) };
+}
+inline simd_int select(const simd_mask& mask, const simd_int& a, const simd_int& b)
 {
-    return T{(mask.AND() ? a : b)};
+    return simd_int{ Detail::select<simd_int::simd_type>(mask.maski(), a.simd(), b.simd()) };
 }
 
-template <typename T, typename F> inline T apply(const T& a, const F& func)
+template <typename F> inline simd_float apply(const simd_float& a, const F& func)
 {
-    return T{func(a.simd())};
+    if constexpr (Detail::isSimdCallable<F, simd_float>::value) {
+        return simd_float{ func(a) };
+    } else {
+        return simd_float{ func(a.simd()) };
+    }
+}
+template <typename F> inline simd_int apply(const simd_int& a, const F& func)
+{
+    if constexpr (Detail::isSimdCallable<F, simd_int>::value) {
+        return simd_int{ func(a) };
+    } else {
+        return simd_int{ func(a.simd()) };
+    }
 }
 
+// Round half to even, as _mm_round_ps(a, _MM_FROUND_NINT) does
 inline simd_float round(const simd_float& a)
 {
-    return simd_float{std::round(a.simd())};
+    return simd_float{std::nearbyint(a.simd())};
 }
 
 inline simd_mask isInf(const simd_float& a)
@@ -13,7 +13,9 @@ Emails: mithran@fias.uni-frankfurt.de
 #include "simd_scalar_detail_mask.h"
 #include "simd_scalar_type.h"
 
+#include <cassert>
 #include <cmath>
+#include <string>
 
 namespace KFP {
 namespace SIMD {
@@ -64,6 +66,22 @@ template <> inline simd_mask& simd_mask::operator=(const simd_mask& class_mask)
     return *this ;
 }
 
+// ------------------------------------------------------
+// Load and Store
+// ------------------------------------------------------
+template <> inline simd_mask& simd_mask::load(const bool* val_ptr)
+{
+    mask_ = -int(val_ptr[0]) ;
+    return *this;
+}
+template <> inline void simd_mask::store(bool* val_ptr) const
+{
+    val_ptr[0] = static_cast<bool>(mask_) ;
+}
+
+// ------------------------------------------------------
+// Status accessors
+// ------------------------------------------------------
 template <> inline int simd_mask::count() const
 {
     return -(mask_) ;
@@ -86,6 +104,38 @@ template <> inline simd_float::simd_type simd_mask::maskf() const
     return static_cast<simd_float::simd_type>(mask_);
 }
 
+// ------------------------------------------------------
+// Data elements manipulation
+// ------------------------------------------------------
+template <> inline simd_mask& simd_mask::insert(int index, bool val)
+{
+    assert((index == 0) &&
+           ("[Error] (insert): invalid index (" + std::to_string(index) +
+            ") given. Non-zero index not allowed.")
+               .data());
+    if (index == 0) {
+        mask_ = -int(val) ;
+    }
+    return *this;
+}
+template <> inline simd_mask simd_mask::insertCopy(int index, bool val) const
+{
+    simd_mask result{*this};
+    return result.insert(index, val);
+}
+template <> inline simd_mask& simd_mask::cutoff(int n)
+{
+    if (n < 1) {
+        mask_ = 0 ;
+    }
+    return *this;
+}
+template <> inline simd_mask simd_mask::cutoffCopy(int n) const
+{
+    simd_mask result{*this};
+    return result.cutoff(n);
+}
+
 } // namespace SIMD
 } // namespace KFP
 
@@ -12,7 +12,9 @@ Emails: mithran@fias.uni-frankfurt.de
 #include "../Base/simd_data.h"
 #include "../Base/simd_mask.h"
 #include "../Base/simd_class.h"
+#include "../Base/simd_constant.h"
 
+#include <cstdint>
 #include <type_traits>
 
 namespace KFP {
@@ -32,6 +34,9 @@ static_assert(std::is_same<simd_int::simd_type, int>::value,
 static_assert(std::is_same<simd_int::value_type, int>::value,
               "[Error]: Invalid value type for Scalar int SimdClass.");
 
+template <typename ValueType, std::uint32_t Bits>
+using simd_constant = SimdConstantBase<ValueType, Bits, Tag::Scalar>;
+
 namespace Detail{
 
 typedef simd_int::simd_type SimdDataI;
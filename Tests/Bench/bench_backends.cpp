@@ -0,0 +1,208 @@
+// -*- C++ -*-
+// Runs the same simd_float/simd_int kernels on whichever backend the file is
+// compiled for and reports the time per element. Build it once per backend:
+//
+//   g++ -std=c++17 -O2 -D__KFP_SIMD__=0 bench_backends.cpp -o bench_scalar
+//   g++ -std=c++17 -O2 -msse4.2        bench_backends.cpp -o bench_sse
+//   g++ -std=c++17 -O2 -mavx2          bench_backends.cpp -o bench_avx
+//
+//   ./bench_scalar > scalar.txt
+//   ./bench_avx scalar.txt   # prints the speedup ratio against the Scalar run
+//
+#include "../../simd.h"
+#include "../../Base/simd_tag.h"
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+using KFP::SIMD::simd_mask;
+using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_int;
+using KFP::SIMD::Vector;
+
+constexpr int NElements = 1 << 16;
+constexpr int NRepeat = 200;
+
+// ------------------------------------------------------
+// Kernels
+// ------------------------------------------------------
+__KFP_SIMD__INLINE simd_float sinSeries(const simd_float& x)
+{
+    const simd_float x2 = x * x;
+    simd_float y = -1.984126984e-4f;
+    y = y * x2 + 8.333333333e-3f;
+    y = y * x2 - 1.666666667e-1f;
+    return y * (x2 * x) + x;
+}
+
+__KFP_SIMD__INLINE simd_float cosSeries(const simd_float& x)
+{
+    const simd_float x2 = x * x;
+    simd_float y = 2.48015873e-5f;
+    y = y * x2 - 1.388888889e-03f;
+    y = y * x2 + 4.166666667e-2f;
+    return y * (x2 * x2) - .5f * x2 + 1.f;
+}
+
+__KFP_SIMD__INLINE simd_float sincosSum(simd_float x)
+{
+    const simd_int nPi2{ round(x * simd_float{ 6.36619772e-1f }) };
+    const simd_int q = nPi2 & simd_int{ 3 };
+    const simd_float nPi2f{ nPi2 };
+    x = x - simd_float{ 1.5707969666f } * nPi2f;
+    x = x + simd_float{ 6.3975784e-7f } * nPi2f;
+    const simd_float sinS = sinSeries(x);
+    const simd_float cosS = cosSeries(x);
+    const simd_mask mask = (q == simd_int{ 0 }) || (q == simd_int{ 2 });
+    const simd_float sinSign = simd_float::type_cast(q << 30);
+    const simd_float cosSign = simd_float::type_cast((q + simd_int{ 1 }) << 30);
+    return (sinSign.sign() ^ select(mask, sinS, cosS)) +
+           (cosSign.sign() ^ select(mask, cosS, sinS));
+}
+
+struct KernelPolynomial
+{
+    static const char* name()
+    {
+        return "polynomial";
+    }
+    simd_float operator()(const simd_float& x, const simd_float&) const
+    {
+        return ((simd_float{ 0.5f } * x + 1.5f) * x - 2.0f) * x + 3.0f;
+    }
+};
+
+struct KernelNorm
+{
+    static const char* name()
+    {
+        return "sqrt_div";
+    }
+    simd_float operator()(const simd_float& x, const simd_float& y) const
+    {
+        return x / sqrt(x * x + y * y + 1.0f);
+    }
+};
+
+struct KernelSinCos
+{
+    static const char* name()
+    {
+        return "sincos";
+    }
+    simd_float operator()(const simd_float& x, const simd_float&) const
+    {
+        return sincosSum(x);
+    }
+};
+
+struct KernelSelect
+{
+    static const char* name()
+    {
+        return "select_minmax";
+    }
+    simd_float operator()(const simd_float& x, const simd_float& y) const
+    {
+        const simd_float lo = min(x, y);
+        const simd_float hi = max(x, y);
+        return select(abs(x) > simd_float{ 1.0f }, hi - lo, lo * hi);
+    }
+};
+
+// ------------------------------------------------------
+// Driver
+// ------------------------------------------------------
+template <typename Kernel>
+double runKernel(const float* x, const float* y, float* out)
+{
+    const Kernel kernel{};
+    const auto start = std::chrono::steady_clock::now();
+    for (int iRepeat = 0; iRepeat < NRepeat; ++iRepeat) {
+        for (int idx = 0; idx < NElements; idx += simd_float::SimdLen) {
+            const simd_float vx = simd_float{}.load_a(x + idx);
+            const simd_float vy = simd_float{}.load_a(y + idx);
+            kernel(vx, vy).store_a(out + idx);
+        }
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() /
+           (double(NElements) * NRepeat);
+}
+
+double runGather(const float* x, const int* indices, float* out)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int iRepeat = 0; iRepeat < NRepeat; ++iRepeat) {
+        for (int idx = 0; idx < NElements; idx += simd_float::SimdLen) {
+            const simd_int index = simd_int{}.load_a(indices + idx);
+            simd_float{}.gather(x, index).store_a(out + idx);
+        }
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() /
+           (double(NElements) * NRepeat);
+}
+
+std::map<std::string, double> readBaseline(const char* file_name)
+{
+    std::map<std::string, double> baseline;
+    std::ifstream file(file_name);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream stream(line);
+        std::string tag, kernel;
+        double time{ 0.0 };
+        if (stream >> tag >> kernel >> time) {
+            baseline[kernel] = time;
+        }
+    }
+    return baseline;
+}
+
+int main(int argc, char* argv[])
+{
+    constexpr std::size_t Alignment = simd_float::SimdSize;
+    Vector<float, Alignment> x(NElements), y(NElements), out(NElements);
+    Vector<int, Alignment> indices(NElements);
+    for (std::size_t idx = 0; idx < NElements; ++idx) {
+        const int i = static_cast<int>(idx);
+        x[idx] = -4.0f + 8.0f * float(i) / NElements;
+        y[idx] = 3.0f - 5.0f * float(i % 97) / 97.0f;
+        indices[idx] = (i * 7919) % NElements;
+    }
+
+    std::map<std::string, double> results;
+    results[KernelPolynomial::name()] = runKernel<KernelPolynomial>(x.data(), y.data(), out.data());
+    results[KernelNorm::name()] = runKernel<KernelNorm>(x.data(), y.data(), out.data());
+    results[KernelSinCos::name()] = runKernel<KernelSinCos>(x.data(), y.data(), out.data());
+    results[KernelSelect::name()] = runKernel<KernelSelect>(x.data(), y.data(), out.data());
+    results["gather"] = runGather(x.data(), indices.data(), out.data());
+
+    // Consume the output so the kernels are not optimised away
+    float checksum{ 0.0f };
+    for (std::size_t idx = 0; idx < NElements; ++idx) {
+        checksum += out[idx];
+    }
+    std::cerr << "checksum " << checksum << '\n';
+
+    const std::map<std::string, double> baseline =
+        (argc > 1) ? readBaseline(argv[1]) : std::map<std::string, double>{};
+    for (const auto& result : results) {
+        std::cout << KFP::SIMD::getTagStr() << ' ' << std::left << std::setw(16)
+                  << result.first << ' ' << std::fixed << std::setprecision(4)
+                  << result.second;
+        const auto base = baseline.find(result.first);
+        if (base != baseline.end()) {
+            std::cout << "  speedup " << std::setprecision(2)
+                      << base->second / result.second;
+        }
+        std::cout << '\n';
+    }
+}
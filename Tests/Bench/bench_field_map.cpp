@@ -0,0 +1,132 @@
+// -*- C++ -*-
+// Trilinear field map lookup: one point at a time (scalar code on the same
+// SoA map) against SimdFieldMap::get, on random points in a 21^3 grid which
+// stays in cache and a 201^3 grid (97 MB) where the corner loads miss.
+// Build it once per backend:
+//
+//   g++ -std=c++17 -O2 -DNDEBUG -D__KFP_SIMD__=0 bench_field_map.cpp -o bench_field_map_scalar
+//   g++ -std=c++17 -O2 -DNDEBUG -msse4.2         bench_field_map.cpp -o bench_field_map_sse
+//   g++ -std=c++17 -O2 -DNDEBUG -mavx2 -mfma     bench_field_map.cpp -o bench_field_map_avx
+//
+// The field sums printed on stderr must agree to float precision.
+//
+#include "../../Track/simd_field_map.h"
+#include "../../Base/simd_tag.h"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+using KFP::SIMD::simd_float;
+using KFP::SIMD::SimdFieldMap;
+using FloatVector = KFP::SIMD::Vector<float, simd_float::SimdSize>;
+
+constexpr std::size_t NPoints = 1 << 14;
+constexpr int NRepeat = 100;
+
+// ------------------------------------------------------
+// Point by point lookup
+// ------------------------------------------------------
+void getScalar(const SimdFieldMap& map, float x, float y, float z, float (&B)[3])
+{
+    const float pos[3]{ x, y, z };
+    int cell[3];
+    float frac[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        const float u = (pos[axis] - map.node(axis, 0)) / (map.node(axis, 1) - map.node(axis, 0));
+        if (!(u >= 0.0f && u <= float(map.size(axis) - 1))) {
+            B[0] = B[1] = B[2] = 0.0f;
+            return;
+        }
+        cell[axis] = std::min(int(u), map.size(axis) - 2);
+        frac[axis] = u - float(cell[axis]);
+    }
+    const int i000 = map.index(cell[0], cell[1], cell[2]);
+    const int strideY = map.size(2);
+    const int strideX = map.size(1) * map.size(2);
+    for (int c = 0; c < 3; ++c) {
+        const float* v = map.component(c);
+        const auto lerp = [](float a, float b, float t) { return a + t * (b - a); };
+        const float c00 = lerp(v[i000], v[i000 + 1], frac[2]);
+        const float c01 = lerp(v[i000 + strideY], v[i000 + strideY + 1], frac[2]);
+        const float c10 = lerp(v[i000 + strideX], v[i000 + strideX + 1], frac[2]);
+        const float c11 = lerp(v[i000 + strideX + strideY], v[i000 + strideX + strideY + 1], frac[2]);
+        B[c] = lerp(lerp(c00, c01, frac[1]), lerp(c10, c11, frac[1]), frac[0]);
+    }
+}
+
+// ------------------------------------------------------
+// Driver
+// ------------------------------------------------------
+template <typename Run> void runBench(const char* name, int nNodes, const Run& run)
+{
+    double sum = 0.0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int iRepeat = 0; iRepeat < NRepeat; ++iRepeat) {
+        sum += run();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    const double time =
+        std::chrono::duration<double, std::nano>(stop - start).count() / (double(NPoints) * NRepeat);
+    std::cout << KFP::SIMD::getTagStr() << ' ' << std::left << std::setw(8) << name << ' '
+              << std::setw(4) << nNodes << ' '
+              << std::fixed << std::setprecision(3) << time << " ns/point\n";
+    std::cerr << name << " field sum " << std::setprecision(6) << sum / NRepeat << '\n';
+}
+
+void runMap(int nNodes)
+{
+    const float step = 200.0f / float(nNodes - 1);
+    SimdFieldMap map{ nNodes, nNodes, nNodes, { -100.0f, -100.0f, -100.0f }, { step, step, step } };
+    for (int ix = 0; ix < nNodes; ++ix) {
+        for (int iy = 0; iy < nNodes; ++iy) {
+            for (int iz = 0; iz < nNodes; ++iz) {
+                const float x = map.node(0, ix);
+                const float y = map.node(1, iy);
+                const float z = map.node(2, iz);
+                map.set(ix, iy, iz, 1e-3f * x * z, -1e-3f * y * z, 5.0f - 1e-4f * (x * x + y * y));
+            }
+        }
+    }
+    FloatVector px(NPoints), py(NPoints), pz(NPoints);
+    std::mt19937 gen{ 42 };
+    std::uniform_real_distribution<float> dist{ -99.0f, 99.0f };
+    for (std::size_t i = 0; i < NPoints; ++i) {
+        px[i] = dist(gen);
+        py[i] = dist(gen);
+        pz[i] = dist(gen);
+    }
+
+    runBench("scalar", nNodes, [&]() {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < NPoints; ++i) {
+            float B[3];
+            getScalar(map, px[i], py[i], pz[i], B);
+            sum += B[0] + B[1] + B[2];
+        }
+        return sum;
+    });
+    runBench("simd", nNodes, [&]() {
+        simd_float acc{ 0.0f };
+        for (std::size_t i = 0; i < NPoints; i += simd_float::SimdLen) {
+            simd_float B[3];
+            map.get(simd_float{}.load_a(&px[i]), simd_float{}.load_a(&py[i]),
+                    simd_float{}.load_a(&pz[i]), B);
+            acc += B[0] + B[1] + B[2];
+        }
+        double sum = 0.0;
+        for (int iLane = 0; iLane < simd_float::SimdLen; ++iLane) {
+            sum += acc[iLane];
+        }
+        return sum;
+    });
+}
+
+int main()
+{
+    runMap(21);
+    runMap(201);
+    return 0;
+}
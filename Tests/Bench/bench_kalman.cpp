@@ -0,0 +1,191 @@
+// -*- C++ -*-
+// Kalman measurement update of 5-parameter tracks with a 2D hit, per track
+// (scalar float loops, the usual hand-written version) against the batched
+// kernel of Track/simd_kalman.h. Build it once per backend:
+//
+//   g++ -std=c++17 -O2 -DNDEBUG -D__KFP_SIMD__=0 bench_kalman.cpp -o bench_kalman_scalar
+//   g++ -std=c++17 -O2 -DNDEBUG -msse4.2         bench_kalman.cpp -o bench_kalman_sse
+//   g++ -std=c++17 -O2 -DNDEBUG -mavx2 -mfma     bench_kalman.cpp -o bench_kalman_avx
+//
+// The chi2 sums printed on stderr must agree to float precision.
+//
+#include "../../Track/simd_kalman.h"
+#include "../../Base/simd_tag.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_mask;
+using KFP::SIMD::SimdMatrix;
+using KFP::SIMD::SimdProjection;
+using KFP::SIMD::SimdSymMatrix;
+using KFP::SIMD::SimdTrackState;
+using FloatVector = KFP::SIMD::Vector<float, simd_float::SimdSize>;
+
+constexpr std::size_t NTracks = 1 << 12;
+constexpr int NRepeat = 200;
+constexpr std::size_t NPar = 5;
+constexpr std::size_t NCov = NPar * (NPar + 1) / 2;
+
+// Tracks in SoA: parameter i of track t at x[i * NTracks + t]
+struct Tracks
+{
+    FloatVector x = FloatVector(NPar * NTracks);
+    FloatVector C = FloatVector(NCov * NTracks);
+    FloatVector m = FloatVector(2 * NTracks);
+    FloatVector chi2 = FloatVector(NTracks);
+
+    Tracks()
+    {
+        for (std::size_t t = 0; t < NTracks; ++t) {
+            for (std::size_t i = 0; i < NPar; ++i) {
+                x[i * NTracks + t] = 0.1f * float(i + 1) + 1e-4f * float(t % 97);
+                for (std::size_t j = 0; j <= i; ++j) {
+                    C[(i * (i + 1) / 2 + j) * NTracks + t] = (i == j) ? 1.0f + 0.1f * float(i) : 0.01f;
+                }
+            }
+            m[t] = 0.3f - 1e-4f * float(t % 31);
+            m[NTracks + t] = -0.1f + 1e-4f * float(t % 13);
+            chi2[t] = 0.0f;
+        }
+    }
+};
+
+// ------------------------------------------------------
+// Per track version
+// ------------------------------------------------------
+void updateScalar(Tracks& tracks)
+{
+    const float V[3]{ 0.01f, 0.005f, 0.04f };
+    for (std::size_t t = 0; t < NTracks; ++t) {
+        float x[NPar];
+        float C[NCov];
+        for (std::size_t i = 0; i < NPar; ++i) {
+            x[i] = tracks.x[i * NTracks + t];
+        }
+        for (std::size_t k = 0; k < NCov; ++k) {
+            C[k] = tracks.C[k * NTracks + t];
+        }
+        // H selects x[0] and x[1]
+        const float r0 = tracks.m[t] - x[0];
+        const float r1 = tracks.m[NTracks + t] - x[1];
+        const float S00 = C[0] + V[0];
+        const float S10 = C[1] + V[1];
+        const float S11 = C[2] + V[2];
+        const float det = S00 * S11 - S10 * S10;
+        if (!(det > 0.0f) || !(S00 > 0.0f)) {
+            continue;
+        }
+        const float inv = 1.0f / det;
+        const float I00 = S11 * inv;
+        const float I10 = -S10 * inv;
+        const float I11 = S00 * inv;
+        float K0[NPar];
+        float K1[NPar];
+        float CHt0[NPar];
+        float CHt1[NPar];
+        for (std::size_t i = 0; i < NPar; ++i) {
+            CHt0[i] = C[SimdSymMatrix<NPar>::index(static_cast<int>(i), 0)];
+            CHt1[i] = C[SimdSymMatrix<NPar>::index(static_cast<int>(i), 1)];
+            K0[i] = CHt0[i] * I00 + CHt1[i] * I10;
+            K1[i] = CHt0[i] * I10 + CHt1[i] * I11;
+            x[i] += K0[i] * r0 + K1[i] * r1;
+        }
+        for (std::size_t i = 0; i < NPar; ++i) {
+            for (std::size_t j = 0; j <= i; ++j) {
+                C[i * (i + 1) / 2 + j] -= K0[i] * CHt0[j] + K1[i] * CHt1[j];
+            }
+        }
+        tracks.chi2[t] += r0 * (I00 * r0 + I10 * r1) + r1 * (I10 * r0 + I11 * r1);
+        for (std::size_t i = 0; i < NPar; ++i) {
+            tracks.x[i * NTracks + t] = x[i];
+        }
+        for (std::size_t k = 0; k < NCov; ++k) {
+            tracks.C[k * NTracks + t] = C[k];
+        }
+    }
+}
+
+// ------------------------------------------------------
+// Batched versions
+// ------------------------------------------------------
+template <typename Update> void updateSimd(Tracks& tracks, const Update& update)
+{
+    SimdSymMatrix<2> V;
+    V(0, 0) = simd_float{ 0.01f };
+    V(1, 0) = simd_float{ 0.005f };
+    V(1, 1) = simd_float{ 0.04f };
+    for (std::size_t t = 0; t < NTracks; t += simd_float::SimdLen) {
+        SimdTrackState<NPar> track;
+        for (std::size_t i = 0; i < NPar; ++i) {
+            track.x(i, 0).load_a(&tracks.x[i * NTracks + t]);
+        }
+        track.C.loadSoA(&tracks.C[t], NTracks);
+        track.chi2.load_a(&tracks.chi2[t]);
+        SimdMatrix<2, 1> m;
+        m(0, 0).load_a(&tracks.m[t]);
+        m(1, 0).load_a(&tracks.m[NTracks + t]);
+        update(track, m, V);
+        for (std::size_t i = 0; i < NPar; ++i) {
+            track.x(i, 0).store_a(&tracks.x[i * NTracks + t]);
+        }
+        track.C.storeSoA(&tracks.C[t], NTracks);
+        track.chi2.store_a(&tracks.chi2[t]);
+    }
+}
+
+struct UpdateProjection
+{
+    void operator()(SimdTrackState<NPar>& track, const SimdMatrix<2, 1>& m,
+                    const SimdSymMatrix<2>& V) const
+    {
+        kalmanUpdate(track, SimdProjection<0, 1>{}, m, V);
+    }
+};
+
+struct UpdateDense
+{
+    SimdMatrix<2, NPar> H;
+    UpdateDense() : H{}
+    {
+        H(0, 0) = simd_float{ 1.0f };
+        H(1, 1) = simd_float{ 1.0f };
+    }
+    void operator()(SimdTrackState<NPar>& track, const SimdMatrix<2, 1>& m,
+                    const SimdSymMatrix<2>& V) const
+    {
+        kalmanUpdate(track, H, m, V);
+    }
+};
+
+// ------------------------------------------------------
+// Driver
+// ------------------------------------------------------
+template <typename Run> void runBench(const char* name, const Run& run)
+{
+    Tracks tracks;
+    const auto start = std::chrono::steady_clock::now();
+    for (int iRepeat = 0; iRepeat < NRepeat; ++iRepeat) {
+        run(tracks);
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    double chi2 = 0.0;
+    for (std::size_t t = 0; t < NTracks; ++t) {
+        chi2 += tracks.chi2[t];
+    }
+    const double time =
+        std::chrono::duration<double, std::nano>(stop - start).count() / (double(NTracks) * NRepeat);
+    std::cout << KFP::SIMD::getTagStr() << ' ' << std::left << std::setw(16) << name << ' '
+              << std::fixed << std::setprecision(3) << time << " ns/track\n";
+    std::cerr << name << " chi2 sum " << std::setprecision(6) << chi2 << '\n';
+}
+
+int main()
+{
+    runBench("per_track", [](Tracks& tracks) { updateScalar(tracks); });
+    runBench("simd_projection", [](Tracks& tracks) { updateSimd(tracks, UpdateProjection{}); });
+    runBench("simd_dense", [](Tracks& tracks) { updateSimd(tracks, UpdateDense{}); });
+    return 0;
+}
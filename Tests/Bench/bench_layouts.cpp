@@ -0,0 +1,178 @@
+// -*- C++ -*-
+// Helix transport of tracks with covariance (29 floats per track: 6
+// parameters, 21 covariance elements, charge and step) stored as AoS, as
+// SoA<...> and as AoSoA<...>. All three run the same SIMD kernel; they only
+// differ in how a batch of tracks is loaded and stored. Build it once per
+// backend:
+//
+//   g++ -std=c++17 -O2 -DNDEBUG -D__KFP_SIMD__=0 bench_layouts.cpp -o bench_layouts_scalar
+//   g++ -std=c++17 -O2 -DNDEBUG -msse4.2         bench_layouts.cpp -o bench_layouts_sse
+//   g++ -std=c++17 -O2 -DNDEBUG -mavx2 -mfma     bench_layouts.cpp -o bench_layouts_avx
+//
+// The checksums printed on stderr must agree.
+//
+#include "../../Track/simd_extrapolation.h"
+#include "../../Base/simd_tag.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using KFP::SIMD::simd_float;
+using KFP::SIMD::SimdTrackCov;
+using KFP::SIMD::SimdTrackParam;
+using KFP::SIMD::Detail::staticFor;
+
+constexpr int NFields = 29;
+constexpr int SimdLen = simd_float::SimdLen;
+constexpr float Bz = 5.0f;
+
+template <int K> using Field = std::integral_constant<int, K>;
+
+// Containers with NFields float fields
+template <template <typename...> class Container, typename Seq> struct FloatFields;
+template <template <typename...> class Container, std::size_t... I>
+struct FloatFields<Container, std::index_sequence<I...>>
+{
+    typedef Container<std::enable_if_t<(I < NFields), float>...> type;
+};
+using TrackSoA = FloatFields<KFP::SIMD::SoA, std::make_index_sequence<NFields>>::type;
+using TrackAoSoA = FloatFields<KFP::SIMD::AoSoA, std::make_index_sequence<NFields>>::type;
+
+struct TrackRecord
+{
+    float field[NFields];
+};
+
+float initialValue(std::size_t track, int k)
+{
+    if (k < 6) {
+        return (k < 3) ? 0.1f * float(track % 17) : 0.2f + 0.1f * float(k) + 1e-4f * float(track % 29);
+    }
+    if (k < 27) {
+        return (k == 6 || k == 8 || k == 11 || k == 15 || k == 20 || k == 26) ? 1.0f : 0.01f;
+    }
+    return (k == 27) ? ((track % 2) ? 1.0f : -1.0f) : 1e-3f;
+}
+
+// ------------------------------------------------------
+// Kernel
+// ------------------------------------------------------
+// load(Field<K>) and store(Field<K>, value) access field K of one batch
+template <typename Load, typename Store> void transportBatch(const Load& load, const Store& store)
+{
+    SimdTrackParam x;
+    SimdTrackCov C;
+    staticFor<6>([&](auto i) { x(i, 0) = load(Field<i>{}); });
+    staticFor<21>([&](auto k) { C[k] = load(Field<6 + k>{}); });
+    KFP::SIMD::transportBz(x, C, load(Field<27>{}), simd_float{ Bz }, load(Field<28>{}));
+    staticFor<6>([&](auto i) { store(Field<i>{}, x(i, 0)); });
+    staticFor<21>([&](auto k) { store(Field<6 + k>{}, C[k]); });
+}
+
+void runAoS(std::vector<TrackRecord>& tracks)
+{
+    const std::size_t n = tracks.size();
+    for (std::size_t t = 0; t < n; t += SimdLen) {
+        // Transpose SimdLen records through an aligned buffer
+        __KFP_SIMD__SPEC_ALIGN(__KFP_SIMD__Size_Float) float buffer[NFields * SimdLen];
+        for (std::size_t iLane = 0; iLane < SimdLen; ++iLane) {
+            for (std::size_t k = 0; k < NFields; ++k) {
+                buffer[k * SimdLen + iLane] = tracks[t + iLane].field[k];
+            }
+        }
+        transportBatch([&](auto k) { return simd_float{}.load_a(buffer + k * SimdLen); },
+                       [&](auto k, const simd_float& value) { value.store_a(buffer + k * SimdLen); });
+        for (std::size_t iLane = 0; iLane < SimdLen; ++iLane) {
+            for (std::size_t k = 0; k < 27; ++k) {
+                tracks[t + iLane].field[k] = buffer[k * SimdLen + iLane];
+            }
+        }
+    }
+}
+
+void runSoA(TrackSoA& tracks)
+{
+    for (std::size_t b = 0; b < tracks.batch_count(); ++b) {
+        transportBatch(
+            [&](auto k) { return simd_float{}.load_a(tracks.column<k>() + b * SimdLen); },
+            [&](auto k, const simd_float& value) { value.store_a(tracks.column<k>() + b * SimdLen); });
+    }
+}
+
+void runAoSoA(TrackAoSoA& tracks)
+{
+    for (TrackAoSoA::Block& block : tracks) {
+        transportBatch([&](auto k) { return block.load<k>(); },
+                       [&](auto k, const simd_float& value) { block.store<k>(value); });
+    }
+}
+
+// ------------------------------------------------------
+// Driver
+// ------------------------------------------------------
+template <typename Run, typename Checksum>
+void runBench(const char* name, std::size_t nTracks, int nRepeat, const Run& run, const Checksum& checksum)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int iRepeat = 0; iRepeat < nRepeat; ++iRepeat) {
+        run();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    const double time =
+        std::chrono::duration<double, std::nano>(stop - start).count() / (double(nTracks) * nRepeat);
+    std::cout << KFP::SIMD::getTagStr() << ' ' << std::left << std::setw(6) << name << ' '
+              << std::setw(7) << nTracks << ' '
+              << std::fixed << std::setprecision(3) << time << " ns/track\n";
+    std::cerr << name << ' ' << nTracks << " checksum " << std::setprecision(6) << checksum() << '\n';
+}
+
+void runLayouts(std::size_t nTracks, int nRepeat)
+{
+    std::vector<TrackRecord> aos(nTracks);
+    TrackSoA soa(nTracks);
+    TrackAoSoA aosoa(nTracks);
+    for (std::size_t t = 0; t < nTracks; ++t) {
+        for (int k = 0; k < NFields; ++k) {
+            aos[t].field[k] = initialValue(t, k);
+        }
+    }
+    aosoa.fromAoS(aos.data(), aos.size());
+    staticFor<NFields>([&](auto k) {
+        for (std::size_t t = 0; t < nTracks; ++t) {
+            soa.get<k>(t) = initialValue(t, k);
+        }
+    });
+
+    runBench("aos", nTracks, nRepeat, [&]() { runAoS(aos); }, [&]() {
+        double sum = 0.0;
+        for (const TrackRecord& track : aos) {
+            sum += track.field[0] + track.field[6];
+        }
+        return sum;
+    });
+    runBench("soa", nTracks, nRepeat, [&]() { runSoA(soa); }, [&]() {
+        double sum = 0.0;
+        for (std::size_t t = 0; t < nTracks; ++t) {
+            sum += soa.get<0>(t) + soa.get<6>(t);
+        }
+        return sum;
+    });
+    runBench("aosoa", nTracks, nRepeat, [&]() { runAoSoA(aosoa); }, [&]() {
+        double sum = 0.0;
+        for (std::size_t t = 0; t < nTracks; ++t) {
+            sum += aosoa.get<0>(t) + aosoa.get<6>(t);
+        }
+        return sum;
+    });
+}
+
+int main()
+{
+    runLayouts(1 << 10, 2000);
+    runLayouts(1 << 18, 10);
+    return 0;
+}
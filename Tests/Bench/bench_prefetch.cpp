@@ -0,0 +1,81 @@
+// -*- C++ -*-
+// Indirect sum over a large value table through a shuffled index array, as
+// when candidates read their daughters, with gather_prefetched at several
+// prefetch distances (0: no prefetch). The fastest distance is the one to use
+// on this machine; it grows with memory latency and shrinks with the work per
+// batch. Build it once per backend:
+//
+//   g++ -std=c++17 -O2 -DNDEBUG -D__KFP_SIMD__=0 bench_prefetch.cpp -o bench_prefetch_scalar
+//   g++ -std=c++17 -O2 -DNDEBUG -msse4.2         bench_prefetch.cpp -o bench_prefetch_sse
+//   g++ -std=c++17 -O2 -DNDEBUG -mavx2 -mfma     bench_prefetch.cpp -o bench_prefetch_avx
+//
+// The checksums printed on stderr must not depend on the distance and agree
+// between backends up to float rounding.
+//
+#include "../../simd.h"
+#include "../../Base/simd_tag.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_mask;
+using FloatVector = KFP::SIMD::Vector<float, simd_float::SimdSize>;
+using IntVector = KFP::SIMD::Vector<int, simd_float::SimdSize>;
+
+constexpr int NRepeat = 5;
+
+double runDistance(const FloatVector& table, const IntVector& indices, std::size_t distance)
+{
+    simd_float sum{ 0.0f };
+    KFP::SIMD::gather_prefetched(
+        table.data(), indices.data(), indices.size(),
+        [&](const simd_float& values, const simd_mask& mask, std::size_t) {
+            // Some work per batch, as a candidate would do
+            sum += select(mask, sqrt(values * values + 1.0f), simd_float{ 0.0f });
+        },
+        distance);
+    double total = 0.0;
+    for (int iLane = 0; iLane < simd_float::SimdLen; ++iLane) {
+        total += sum[iLane];
+    }
+    return total;
+}
+
+void runTable(std::size_t tableSize, std::size_t nIndices)
+{
+    FloatVector table(tableSize);
+    IntVector indices(nIndices);
+    std::mt19937 gen{ 42 };
+    std::uniform_real_distribution<float> value{ 0.0f, 1.0f };
+    std::uniform_int_distribution<int> index{ 0, static_cast<int>(tableSize) - 1 };
+    std::generate(table.begin(), table.end(), [&]() { return value(gen); });
+    std::generate(indices.begin(), indices.end(), [&]() { return index(gen); });
+
+    for (const std::size_t distance : { 0u, 1u, 2u, 4u, 8u, 16u, 32u, 64u }) {
+        double checksum = 0.0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int iRepeat = 0; iRepeat < NRepeat; ++iRepeat) {
+            checksum += runDistance(table, indices, distance);
+        }
+        const auto stop = std::chrono::steady_clock::now();
+        const double time =
+            std::chrono::duration<double, std::nano>(stop - start).count() / (double(nIndices) * NRepeat);
+        std::cout << KFP::SIMD::getTagStr() << " table " << std::setw(6) << (tableSize * sizeof(float) >> 10)
+                  << " KiB distance " << std::setw(2) << distance << ' ' << std::fixed << std::setprecision(3) << time
+                  << " ns/element\n";
+        std::cerr << "table " << tableSize << " distance " << distance << " checksum " << std::setprecision(6)
+                  << checksum << '\n';
+    }
+}
+
+int main()
+{
+    runTable(std::size_t{ 1 } << 16, std::size_t{ 1 } << 22); // fits in L2
+    runTable(std::size_t{ 1 } << 25, std::size_t{ 1 } << 22); // 128 MiB, from memory
+    return 0;
+}
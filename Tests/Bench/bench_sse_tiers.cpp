@@ -0,0 +1,152 @@
+// -*- C++ -*-
+// Per-operation cost of the simd_int/simd_float operations whose SSE
+// implementation depends on the instruction set tier. Build it once per tier
+// and compare the columns (NDEBUG keeps the index asserts out of the loop):
+//
+//   g++ -std=c++17 -O2 -DNDEBUG -msse2   bench_sse_tiers.cpp -o bench_sse2
+//   g++ -std=c++17 -O2 -DNDEBUG -mssse3  bench_sse_tiers.cpp -o bench_ssse3
+//   g++ -std=c++17 -O2 -DNDEBUG -msse4.1 bench_sse_tiers.cpp -o bench_sse41
+//
+// The checksum printed on stderr must be identical for every tier.
+//
+#include "../../simd.h"
+#include "../../Base/simd_tag.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+using KFP::SIMD::simd_mask;
+using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_int;
+using KFP::SIMD::Vector;
+
+constexpr int NElements = 1 << 12;
+constexpr int NRepeat = 2000;
+
+// ------------------------------------------------------
+// Driver
+// ------------------------------------------------------
+// Chains the operation through an accumulator so that the loop measures the
+// latency-bound cost of one operation per vector.
+template <typename Op>
+double runOp(const char* name, const int* a, const int* b, std::uint32_t& checksum)
+{
+    const Op op{};
+    simd_int acc{ 1 };
+    const auto start = std::chrono::steady_clock::now();
+    for (int iRepeat = 0; iRepeat < NRepeat; ++iRepeat) {
+        for (int idx = 0; idx < NElements; idx += simd_int::SimdLen) {
+            const simd_int va = simd_int{}.load_a(a + idx);
+            const simd_int vb = simd_int{}.load_a(b + idx);
+            acc = op(acc ^ va, vb);
+        }
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    for (int iLane = 0; iLane < simd_int::SimdLen; ++iLane) {
+        checksum = checksum * 31u + static_cast<std::uint32_t>(acc[iLane]);
+    }
+    const double time = std::chrono::duration<double, std::nano>(stop - start).count() /
+                        (double(NElements) / simd_int::SimdLen * NRepeat);
+    std::cout << KFP::SIMD::getTagStr() << ' ' << std::left << std::setw(12) << name
+              << ' ' << std::fixed << std::setprecision(3) << time << " ns/op\n";
+    return time;
+}
+
+struct OpMultiply
+{
+    simd_int operator()(const simd_int& a, const simd_int& b) const
+    {
+        return a * b;
+    }
+};
+struct OpDivide
+{
+    simd_int operator()(const simd_int& a, const simd_int& b) const
+    {
+        return a / b;
+    }
+};
+struct OpMin
+{
+    simd_int operator()(const simd_int& a, const simd_int& b) const
+    {
+        return min(a, b);
+    }
+};
+struct OpMax
+{
+    simd_int operator()(const simd_int& a, const simd_int& b) const
+    {
+        return max(a, b);
+    }
+};
+struct OpSelect
+{
+    simd_int operator()(const simd_int& a, const simd_int& b) const
+    {
+        return select(a > b, a, b + simd_int{ 1 });
+    }
+};
+struct OpAbs
+{
+    simd_int operator()(const simd_int& a, const simd_int& b) const
+    {
+        return abs(a) + b;
+    }
+};
+struct OpRotate
+{
+    simd_int operator()(const simd_int& a, const simd_int& b) const
+    {
+        return a.rotateCopy(1) + b;
+    }
+};
+struct OpInsert
+{
+    simd_int operator()(const simd_int& a, const simd_int& b) const
+    {
+        return a.insertCopy(b[0] & (simd_int::SimdLen - 1), 7);
+    }
+};
+struct OpFloatSelect
+{
+    simd_int operator()(const simd_int& a, const simd_int& b) const
+    {
+        const simd_float fa{ a };
+        const simd_float fb{ b };
+        return simd_int{ select(fa < fb, fa, fb) };
+    }
+};
+struct OpFloatRound
+{
+    simd_int operator()(const simd_int& a, const simd_int& b) const
+    {
+        return simd_int{ round(simd_float{ a } * 0.37f) } + b;
+    }
+};
+
+int main()
+{
+    constexpr std::size_t Alignment = simd_int::SimdSize;
+    Vector<int, Alignment> a(NElements), b(NElements);
+    for (std::size_t idx = 0; idx < NElements; ++idx) {
+        const int i = static_cast<int>(idx);
+        a[idx] = (i * 7919) % 20011 - 10005;
+        b[idx] = 1 + (i * 104729) % 97;
+    }
+
+    std::uint32_t checksum{ 0 };
+    runOp<OpMultiply>("multiply", a.data(), b.data(), checksum);
+    runOp<OpDivide>("divide", a.data(), b.data(), checksum);
+    runOp<OpMin>("min", a.data(), b.data(), checksum);
+    runOp<OpMax>("max", a.data(), b.data(), checksum);
+    runOp<OpSelect>("select", a.data(), b.data(), checksum);
+    runOp<OpAbs>("abs", a.data(), b.data(), checksum);
+    runOp<OpRotate>("rotate", a.data(), b.data(), checksum);
+    runOp<OpInsert>("insert", a.data(), b.data(), checksum);
+    runOp<OpFloatSelect>("select_f", a.data(), b.data(), checksum);
+    runOp<OpFloatRound>("round_f", a.data(), b.data(), checksum);
+    std::cerr << "checksum " << checksum << '\n';
+}
@@ -0,0 +1,127 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../Math/simd_cholesky.h"
+
+#include <algorithm>
+#include <cmath>
+
+using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_mask;
+using KFP::SIMD::SimdCholesky;
+using KFP::SIMD::SimdMatrix;
+using KFP::SIMD::SimdSymMatrix;
+
+constexpr int NLanes = simd_float::SimdLen;
+
+// Positive definite test matrix M M^T + N I, different in each lane
+template <int N> SimdSymMatrix<N> makeSpd()
+{
+    SimdMatrix<N, N> M;
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < N; ++j) {
+            M(i, j) = simd_float::iota(0.1f * float((i * 7 + j * 3) % 5)) * 0.25f - 0.3f;
+        }
+    }
+    SimdSymMatrix<N> result = SimdSymMatrix<N>::identity().similarity(M);
+    return result.add(SimdSymMatrix<N>::identity() * simd_float{ float(N) });
+}
+
+template <int N> float maxDeviationFromIdentity(const SimdSymMatrix<N>& A, const SimdSymMatrix<N>& Ainv)
+{
+    float deviation = 0.0f;
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < N; ++j) {
+            simd_float sum{ 0.0f };
+            for (int k = 0; k < N; ++k) {
+                sum += A(i, k) * Ainv(k, j);
+            }
+            const simd_float diff = abs(sum - simd_float{ i == j ? 1.0f : 0.0f });
+            for (int iLane = 0; iLane < NLanes; ++iLane) {
+                deviation = std::max(deviation, diff[iLane]);
+            }
+        }
+    }
+    return deviation;
+}
+
+TEST_CASE_TEMPLATE("Testing Cholesky inversion", T, std::integral_constant<int, 3>,
+                   std::integral_constant<int, 5>, std::integral_constant<int, 6>) {
+    constexpr int N = T::value;
+    const SimdSymMatrix<N> A = makeSpd<N>();
+    const SimdCholesky<N> cholesky{ A };
+    CHECK(cholesky.valid().AND());
+
+    SUBCASE("Testing factor") {
+        float deviation = 0.0f;
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j <= i; ++j) {
+                simd_float sum{ 0.0f };
+                for (int k = 0; k <= j; ++k) {
+                    sum += cholesky.L(i, k) * cholesky.L(j, k);
+                }
+                const simd_float diff = abs(sum - A(i, j));
+                for (int iLane = 0; iLane < NLanes; ++iLane) {
+                    deviation = std::max(deviation, diff[iLane]);
+                }
+            }
+        }
+        CHECK(deviation < 1e-4f);
+    }
+    SUBCASE("Testing inverse") {
+        CHECK(maxDeviationFromIdentity(A, cholesky.inverse()) < 1e-4f);
+        SimdSymMatrix<N> B = A;
+        CHECK(invertCholesky(B).AND());
+        CHECK(maxDeviationFromIdentity(A, B) < 1e-4f);
+    }
+    SUBCASE("Testing solve") {
+        SimdMatrix<N, 2> X;
+        for (int i = 0; i < N; ++i) {
+            X(i, 0) = simd_float{ float(i + 1) };
+            X(i, 1) = simd_float::iota(-float(i));
+        }
+        const SimdMatrix<N, 2> solution = cholesky.solve(A.multiply(X));
+        bool close = true;
+        for (int i = 0; i < N; ++i) {
+            for (int c = 0; c < 2; ++c) {
+                close = close && (abs(solution(i, c) - X(i, c)) < simd_float{ 1e-3f }).AND();
+            }
+        }
+        CHECK(close);
+    }
+}
+
+TEST_CASE("Testing non positive definite lanes") {
+    SimdSymMatrix<3> A = makeSpd<3>();
+    // Lane 0 gets a negative pivot, the last lane a NaN
+    float diag[NLanes];
+    A(1, 1).store(diag);
+    diag[0] = -1.0f;
+    if (NLanes > 1) {
+        diag[NLanes - 1] = std::nanf("");
+    }
+    A(1, 1).load(diag);
+    const SimdSymMatrix<3> good = makeSpd<3>();
+
+    const SimdCholesky<3> cholesky{ A };
+    CHECK_FALSE(cholesky.valid()[0]);
+    CHECK_FALSE(cholesky.valid()[NLanes - 1]);
+    if (NLanes > 2) {
+        CHECK(cholesky.valid()[1]);
+    }
+    const SimdSymMatrix<3> Ainv = cholesky.inverse();
+    bool finite = true;
+    for (int k = 0; k < SimdSymMatrix<3>::Size; ++k) {
+        for (int iLane = 0; iLane < NLanes; ++iLane) {
+            finite = finite && std::isfinite(Ainv[k][iLane]);
+        }
+        CHECK(Ainv[k][0] == 0.0f);
+    }
+    CHECK(finite);
+    if (NLanes > 2) {
+        // Valid lanes are not affected by the others
+        const SimdSymMatrix<3> reference = SimdCholesky<3>{ good }.inverse();
+        CHECK(Ainv[4][1] == reference[4][1]);
+    }
+}
@@ -0,0 +1,145 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../Math/simd_lorentz_vector.h"
+
+#include <cmath>
+
+using KFP::SIMD::simd_float;
+using KFP::SIMD::SimdLorentzVector;
+using KFP::SIMD::SimdVec3;
+
+constexpr int NLanes = simd_float::SimdLen;
+
+// Different momentum in every lane
+SimdVec3 makeMomentum(float scale)
+{
+    const simd_float lane = simd_float::iota(0.0f);
+    return SimdVec3{ lane * 0.3f - 0.8f * scale, simd_float{ 0.5f * scale } - lane * 0.2f,
+                     lane * 0.7f + 0.1f * scale };
+}
+
+bool close(const simd_float& a, const simd_float& b, float tolerance)
+{
+    bool result = true;
+    for (int iLane = 0; iLane < NLanes; ++iLane) {
+        result = result && std::abs(a[iLane] - b[iLane]) <= tolerance * (1.0f + std::abs(b[iLane]));
+    }
+    return result;
+}
+
+TEST_CASE("Testing SimdVec3") {
+    const SimdVec3 a = makeMomentum(1.0f);
+    const SimdVec3 b = makeMomentum(-2.0f);
+
+    const SimdVec3 c = cross(a, b);
+    CHECK(close(dot(c, a), simd_float{ 0.0f }, 1e-5f));
+    CHECK(close(dot(c, b), simd_float{ 0.0f }, 1e-5f));
+    CHECK(close(c.mag2() + dot(a, b) * dot(a, b), a.mag2() * b.mag2(), 1e-5f));
+    CHECK(close(a.unit().mag(), simd_float{ 1.0f }, 1e-6f));
+    CHECK(close((a - b + b).x(), a.x(), 1e-6f));
+    CHECK(close((simd_float{ 2.0f } * a / simd_float{ 2.0f }).z(), a.z(), 1e-6f));
+
+    bool matches = true;
+    for (int iLane = 0; iLane < NLanes; ++iLane) {
+        const float x = a.x()[iLane];
+        const float y = a.y()[iLane];
+        const float z = a.z()[iLane];
+        const float perp = std::sqrt(x * x + y * y);
+        const float theta = std::atan2(perp, z);
+        matches = matches && std::abs(a.perp()[iLane] - perp) < 1e-6f;
+        matches = matches && std::abs(a.phi()[iLane] - std::atan2(y, x)) < 1e-6f;
+        matches = matches && std::abs(a.theta()[iLane] - theta) < 1e-6f;
+        matches = matches && std::abs(a.eta()[iLane] + std::log(std::tan(0.5f * theta))) < 1e-5f;
+        matches = matches && std::abs(a.cosAngle(b)[iLane] -
+                                      (x * b.x()[iLane] + y * b.y()[iLane] + z * b.z()[iLane]) /
+                                          std::sqrt((x * x + y * y + z * z) * b.mag2()[iLane])) < 1e-6f;
+    }
+    CHECK(matches);
+    // Backwards tracks get negative pseudorapidity
+    CHECK(close((-a).eta(), -a.eta(), 1e-6f));
+    SUBCASE("Testing pseudorapidity along the z axis") {
+        const simd_float zero{ 0.0f };
+        CHECK((SimdVec3{ zero, zero, simd_float{ 2.0f } }.eta() == simd_float{ 10e10f }).AND());
+        CHECK((SimdVec3{ zero, zero, simd_float{ -2.0f } }.eta() == simd_float{ -10e10f }).AND());
+        CHECK((SimdVec3{ zero, zero, zero }.eta() == zero).AND());
+        CHECK((SimdLorentzVector{ zero, zero, zero, simd_float{ 1.0f } }.eta() == zero).AND());
+    }
+}
+
+TEST_CASE("Testing SimdLorentzVector") {
+    const float massPi = 0.13957f;
+    const SimdLorentzVector pion1 = SimdLorentzVector::fromMass(makeMomentum(1.0f), simd_float{ massPi });
+    const SimdLorentzVector pion2 = SimdLorentzVector::fromMass(makeMomentum(-2.0f), simd_float{ massPi });
+
+    CHECK(close(pion1.mass(), simd_float{ massPi }, 1e-4f));
+    CHECK(close(dot(pion1, pion1), pion1.mass2(), 1e-6f));
+
+    // Invariant mass of the pair against the explicit formula
+    const SimdLorentzVector sum = pion1 + pion2;
+    const simd_float mass2 = simd_float{ 2.0f * massPi * massPi } + simd_float{ 2.0f } * dot(pion1, pion2);
+    CHECK(close(sum.mass2(), mass2, 1e-5f));
+    CHECK(close(sum.pt(), sum.vect().perp(), 1e-6f));
+    CHECK(close(sum.phi(), sum.vect().phi(), 1e-6f));
+    CHECK(close(sum.mt2(), sum.mass2() + sum.pt() * sum.pt(), 1e-5f));
+
+    SUBCASE("Testing boost") {
+        // Into the rest frame of the pair: no momentum left, energy is the mass
+        const SimdVec3 beta = sum.boostVector();
+        const SimdLorentzVector rest = sum.boostCopy(-beta);
+        CHECK(close(rest.p(), simd_float{ 0.0f }, 1e-4f));
+        CHECK(close(rest.e(), sum.mass(), 1e-4f));
+        // Back-to-back daughters in the rest frame, masses are invariant
+        const SimdLorentzVector d1 = pion1.boostCopy(-beta);
+        const SimdLorentzVector d2 = pion2.boostCopy(-beta);
+        CHECK(close((d1.vect() + d2.vect()).mag(), simd_float{ 0.0f }, 1e-4f));
+        CHECK(close(d1.mass(), simd_float{ massPi }, 1e-3f));
+        CHECK(close(d1.boostCopy(beta).px(), pion1.px(), 1e-4f));
+        // Zero velocity is the identity
+        const SimdLorentzVector same = pion1.boostCopy(SimdVec3{});
+        CHECK(close(same.pz(), pion1.pz(), 1e-6f));
+        CHECK(close(same.e(), pion1.e(), 1e-6f));
+    }
+    SUBCASE("Testing rapidity") {
+        bool matches = true;
+        for (int iLane = 0; iLane < NLanes; ++iLane) {
+            const float e = pion1.e()[iLane];
+            const float pz = pion1.pz()[iLane];
+            matches = matches && std::abs(pion1.rapidity()[iLane] - 0.5f * std::log((e + pz) / (e - pz))) < 1e-5f;
+        }
+        CHECK(matches);
+    }
+}
+
+TEST_CASE("Testing AoS and SoA access") {
+    float aos[4 * 8];
+    float soa[4 * 8];
+    for (int i = 0; i < 4 * 8; ++i) {
+        aos[i] = 0.5f * float(i);
+    }
+    const int n = (NLanes > 1) ? NLanes - 1 : 1;
+    SimdLorentzVector v;
+    v.loadAoS(aos, n);
+    for (int iLane = 0; iLane < n; ++iLane) {
+        CHECK(v.py()[iLane] == aos[4 * iLane + 1]);
+        CHECK(v.e()[iLane] == aos[4 * iLane + 3]);
+    }
+    if (n < NLanes) {
+        CHECK(v.px()[NLanes - 1] == 0.0f);
+    }
+
+    v.storeSoA(soa, NLanes);
+    SimdLorentzVector w;
+    w.loadSoA(soa, NLanes);
+    CHECK((w.pz() == v.pz()).AND());
+
+    // Three-vector from the first three entries of every record
+    float out[4 * 8]{};
+    SimdVec3 p;
+    p.loadAoS(aos, NLanes, 4);
+    p.storeAoS(out, n, 4);
+    CHECK(out[4 * (n - 1) + 2] == aos[4 * (n - 1) + 2]);
+    CHECK(out[3] == 0.0f);
+    CHECK((p.z() == v.pz()).cutoffCopy(n).count() == n);
+}
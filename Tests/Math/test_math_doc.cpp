@@ -0,0 +1,66 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../Math/simd_math.h"
+
+#include <algorithm>
+#include <cmath>
+
+using KFP::SIMD::simd_float;
+
+constexpr int NLanes = simd_float::SimdLen;
+
+TEST_CASE("Testing sincos") {
+    float maxError = 0.0f;
+    for (float start = -100.0f; start < 100.0f; start += 0.01f * NLanes) {
+        const simd_float x = simd_float::iota(0.0f) * 0.01f + start;
+        simd_float sinX, cosX;
+        KFP::SIMD::sincos(x, sinX, cosX);
+        for (int iLane = 0; iLane < NLanes; ++iLane) {
+            maxError = std::max(maxError, std::abs(sinX[iLane] - std::sin(x[iLane])));
+            maxError = std::max(maxError, std::abs(cosX[iLane] - std::cos(x[iLane])));
+        }
+    }
+    CHECK(maxError < 1e-6f);
+    const simd_float zero{ 0.0f };
+    CHECK((KFP::SIMD::sin(zero) == zero).AND());
+    CHECK((KFP::SIMD::cos(zero) == simd_float{ 1.0f }).AND());
+    CHECK(KFP::SIMD::sin(simd_float{ -1.0f })[0] == doctest::Approx(std::sin(-1.0f)).epsilon(1e-6));
+    CHECK(KFP::SIMD::cos(simd_float{ 3.0f })[0] == doctest::Approx(std::cos(3.0f)).epsilon(1e-6));
+}
+
+TEST_CASE("Testing atan and atan2") {
+    float maxError = 0.0f;
+    for (float start = -50.0f; start < 50.0f; start += 0.01f * NLanes) {
+        const simd_float x = simd_float::iota(0.0f) * 0.01f + start;
+        const simd_float r = KFP::SIMD::atan(x);
+        for (int iLane = 0; iLane < NLanes; ++iLane) {
+            maxError = std::max(maxError, std::abs(r[iLane] - std::atan(x[iLane])));
+        }
+    }
+    CHECK(maxError < 3e-7f);
+
+    maxError = 0.0f;
+    for (int iAngle = 0; iAngle < 3600; iAngle += NLanes) {
+        const simd_float phi = (simd_float::iota(0.0f) + float(iAngle)) * 0.1f * 0.0174532925f - 3.14159f;
+        const simd_float radius = simd_float::iota(0.5f) * 3.0f;
+        simd_float s, c;
+        KFP::SIMD::sincos(phi, s, c);
+        const simd_float y = radius * s;
+        const simd_float x = radius * c;
+        const simd_float r = KFP::SIMD::atan2(y, x);
+        for (int iLane = 0; iLane < NLanes; ++iLane) {
+            maxError = std::max(maxError, std::abs(r[iLane] - std::atan2(y[iLane], x[iLane])));
+        }
+    }
+    CHECK(maxError < 5e-7f);
+
+    // Axes and signed zeros as std::atan2
+    const float y[8]{ 0.0f, 0.0f, -0.0f, 1.0f, -1.0f, 0.0f, 2.0f, -3.0f };
+    const float x[8]{ 1.0f, -1.0f, -1.0f, 0.0f, 0.0f, 0.0f, -2.0f, -3.0f };
+    for (int i = 0; i < 8; ++i) {
+        const float r = KFP::SIMD::atan2(simd_float{ y[i] }, simd_float{ x[i] })[0];
+        CHECK(r == doctest::Approx(std::atan2(y[i], x[i])).epsilon(1e-6));
+    }
+}
@@ -0,0 +1,127 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../Math/simd_matrix.h"
+
+#include <cmath>
+
+using KFP::SIMD::simd_float;
+using KFP::SIMD::SimdMatrix;
+using KFP::SIMD::SimdSymMatrix;
+
+constexpr int NLanes = simd_float::SimdLen;
+
+// Scalar reference: F C F^T with full (unpacked) matrices
+template <std::size_t M, std::size_t N>
+void similarityRef(const float (&F)[M][N], const float* packed, float* result)
+{
+    float C[N][N];
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < N; ++j) {
+            C[i][j] = packed[SimdSymMatrix<N>::index(static_cast<int>(i), static_cast<int>(j))];
+        }
+    }
+    for (std::size_t i = 0; i < M; ++i) {
+        for (std::size_t j = 0; j <= i; ++j) {
+            double sum = 0.0;
+            for (std::size_t k = 0; k < N; ++k) {
+                for (std::size_t l = 0; l < N; ++l) {
+                    sum += double(F[i][k]) * C[k][l] * F[j][l];
+                }
+            }
+            result[SimdSymMatrix<M>::index(static_cast<int>(i), static_cast<int>(j))] = float(sum);
+        }
+    }
+}
+
+TEST_CASE("Testing SimdSymMatrix") {
+    SUBCASE("Testing packed layout") {
+        CHECK(SimdSymMatrix<6>::Size == 21);
+        CHECK(SimdSymMatrix<8>::Size == 36);
+        CHECK(SimdSymMatrix<6>::index(0, 0) == 0);
+        CHECK(SimdSymMatrix<6>::index(1, 0) == 1);
+        CHECK(SimdSymMatrix<6>::index(0, 1) == 1);
+        CHECK(SimdSymMatrix<6>::index(5, 5) == 20);
+    }
+
+    float cov[NLanes][21];
+    for (int iLane = 0; iLane < NLanes; ++iLane) {
+        for (int k = 0; k < 21; ++k) {
+            cov[iLane][k] = 0.1f * float((k * 3 + iLane) % 7) + ((k == 0 || k == 2 || k == 5 || k == 9 || k == 14 || k == 20) ? 2.0f : 0.0f);
+        }
+    }
+    SimdSymMatrix<6> C;
+    C.loadAoS(&cov[0][0]);
+
+    SUBCASE("Testing AoS load and store") {
+        CHECK(C(2, 1)[NLanes - 1] == cov[NLanes - 1][4]);
+        CHECK(C(1, 2)[0] == cov[0][4]);
+        float out[NLanes][21]{};
+        C.storeAoS(&out[0][0], NLanes);
+        bool all_equal = true;
+        for (int iLane = 0; iLane < NLanes; ++iLane) {
+            for (int k = 0; k < 21; ++k) {
+                all_equal = all_equal && (out[iLane][k] == cov[iLane][k]);
+            }
+        }
+        CHECK(all_equal);
+        SimdSymMatrix<6> partial;
+        partial.loadAoS(&cov[0][0], 1);
+        CHECK(partial[3][0] == cov[0][3]);
+        CHECK(partial[3][NLanes - 1] == (NLanes > 1 ? 0.0f : cov[0][3]));
+    }
+    SUBCASE("Testing add and scale") {
+        const SimdSymMatrix<6> sum = C + C * simd_float{ 2.0f };
+        CHECK((sum[7] == C[7] * 3.0f).AND());
+        SimdSymMatrix<6> scaled = C;
+        scaled.scale(simd_float{ 0.5f }).add(scaled);
+        CHECK((scaled[20] == C[20]).AND());
+    }
+    SUBCASE("Testing similarity") {
+        float F[6][6];
+        float G[3][6];
+        SimdMatrix<6, 6> Fs;
+        SimdMatrix<3, 6> Gs;
+        for (int i = 0; i < 6; ++i) {
+            for (int j = 0; j < 6; ++j) {
+                F[i][j] = (i == j ? 1.0f : 0.0f) + 0.05f * float((i + 2 * j) % 5);
+                Fs(i, j) = simd_float{ F[i][j] };
+                if (i < 3) {
+                    G[i][j] = 0.3f * float((i * j) % 4) - 0.2f;
+                    Gs(i, j) = simd_float{ G[i][j] };
+                }
+            }
+        }
+        const SimdSymMatrix<6> CF = C.similarity(Fs);
+        const SimdSymMatrix<3> CG = C.similarity(Gs);
+        float out6[NLanes][21]{};
+        float out3[NLanes][6]{};
+        CF.storeAoS(&out6[0][0]);
+        CG.storeAoS(&out3[0][0]);
+        bool close = true;
+        for (int iLane = 0; iLane < NLanes; ++iLane) {
+            float ref6[21];
+            float ref3[6];
+            similarityRef(F, cov[iLane], ref6);
+            similarityRef(G, cov[iLane], ref3);
+            for (int k = 0; k < 21; ++k) {
+                close = close && std::abs(out6[iLane][k] - ref6[k]) < 1e-4f * (1.0f + std::abs(ref6[k]));
+            }
+            for (int k = 0; k < 6; ++k) {
+                close = close && std::abs(out3[iLane][k] - ref3[k]) < 1e-4f * (1.0f + std::abs(ref3[k]));
+            }
+        }
+        CHECK(close);
+        const SimdSymMatrix<6> same = C.similarity(SimdMatrix<6, 6>::identity());
+        CHECK((same[11] == C[11]).AND());
+    }
+    SUBCASE("Testing dense products") {
+        const SimdMatrix<6, 2> B = SimdMatrix<2, 6>::identity().transpose();
+        const SimdMatrix<6, 2> CB = C.multiply(B);
+        CHECK((CB(4, 1) == C(4, 1)).AND());
+        const SimdMatrix<2, 2> BtB = B.transpose() * B;
+        CHECK((BtB(1, 1) == simd_float{ 1.0f }).AND());
+        CHECK((BtB(0, 1) == simd_float{ 0.0f }).AND());
+    }
+}
@@ -0,0 +1,136 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../simd.h"
+
+#include <algorithm>
+#include <cmath>
+
+using KFP::SIMD::simd_mask;
+using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_int;
+using KFP::SIMD::Vector;
+
+struct SimdSquare
+{
+    simd_float operator()(const simd_float& x) const
+    {
+        return x * x;
+    }
+};
+
+TEST_CASE("Testing apply") {
+    const simd_float val = simd_float::iota(1.0f);
+    SUBCASE("Testing simd callable functors") {
+        CHECK(KFP::SIMD::Detail::isSimdCallable<SimdSquare, simd_float>::value);
+        CHECK((apply(val, SimdSquare{}) == val * val).AND());
+        CHECK((apply(val, [](const auto& x) { return x + x; }) == val + val).AND());
+        CHECK((apply(simd_int{3}, [](const simd_int& x) { return x * x; }) == simd_int{9}).AND());
+    }
+    SUBCASE("Testing scalar callbacks") {
+        auto scalar_sqrt = [](float x) { return std::sqrt(x); };
+        CHECK_FALSE(KFP::SIMD::Detail::isSimdCallable<decltype(scalar_sqrt), simd_float>::value);
+        CHECK((apply(val * val, scalar_sqrt) == val).AND());
+        CHECK((apply(simd_int{-4}, [](int x) { return -x; }) == simd_int{4}).AND());
+    }
+}
+
+TEST_CASE("Testing transform") {
+    for (int size : {0, 1, simd_float::SimdLen, 3 * simd_float::SimdLen + 1, 37}) {
+        Vector<float, simd_float::SimdSize> in(static_cast<std::size_t>(size));
+        for (std::size_t idx = 0; idx < in.size(); ++idx) {
+            in[idx] = 0.5f * float(idx);
+        }
+        Vector<float, simd_float::SimdSize> out;
+        KFP::SIMD::transform(in, out, [](const simd_float& x) { return x * 2.0f + 1.0f; });
+        REQUIRE(out.size() == in.size());
+        bool all_equal = true;
+        for (std::size_t idx = 0; idx < in.size(); ++idx) {
+            all_equal = all_equal && (out[idx] == in[idx] * 2.0f + 1.0f);
+        }
+        CHECK(all_equal);
+    }
+    SUBCASE("Testing unaligned pointers and scalar callbacks") {
+        float in[11]{};
+        float out[11]{};
+        for (int idx = 0; idx < 11; ++idx) {
+            in[idx] = float(idx);
+        }
+        KFP::SIMD::transform(in + 1, out + 1, 10, [](float x) { return -x; });
+        CHECK(out[0] == 0.0f);
+        CHECK(out[1] == -1.0f);
+        CHECK(out[10] == -10.0f);
+    }
+    SUBCASE("Testing int in place") {
+        Vector<int> data{1, 2, 3, 4, 5};
+        KFP::SIMD::transform(data, data, [](const simd_int& x) { return x << 1; });
+        CHECK(data[4] == 10);
+    }
+}
+
+TEST_CASE("Testing reductions") {
+    for (int size : {0, 1, 3, simd_float::SimdLen, 4 * simd_float::SimdLen, 4 * simd_float::SimdLen + 3, 101}) {
+        Vector<float, simd_float::SimdSize> data(static_cast<std::size_t>(size));
+        float sum{ 0.0f };
+        float sum_sq{ 0.0f };
+        float max_ref{ -100.0f };
+        for (std::size_t idx = 0; idx < data.size(); ++idx) {
+            data[idx] = float((idx * 7) % 13) - 6.0f;
+            sum += data[idx];
+            sum_sq += data[idx] * data[idx];
+            max_ref = std::max(max_ref, data[idx]);
+        }
+        CHECK(KFP::SIMD::reduce(data) == sum);
+        CHECK(KFP::SIMD::reduce(data, 1.0f) == sum + 1.0f);
+        CHECK(KFP::SIMD::transform_reduce(
+                  data, 0.0f, [](const simd_float& a, const simd_float& b) { return a + b; },
+                  [](const simd_float& x) { return x * x; }) == sum_sq);
+        const float max_val = KFP::SIMD::reduce(
+            data, -100.0f, [](const simd_float& a, const simd_float& b) { return max(a, b); });
+        CHECK(max_val == max_ref);
+        std::size_t n_positive{ 0 };
+        for (std::size_t idx = 0; idx < data.size(); ++idx) {
+            n_positive += (data[idx] > 0.0f);
+        }
+        CHECK(KFP::SIMD::count_if(data, [](const simd_float& x) { return x > 0.0f; }) == n_positive);
+    }
+    SUBCASE("Testing int and unaligned reductions") {
+        const int data[]{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+        CHECK(KFP::SIMD::reduce(data + 1, 10) == 65);
+        CHECK(KFP::SIMD::count_if(data + 1, 10, [](const simd_int& x) { return (x & simd_int{1}) == simd_int{0}; }) == 5);
+    }
+}
+
+TEST_CASE("Testing searches") {
+    Vector<float, simd_float::SimdSize> data(29);
+    for (std::size_t idx = 0; idx < data.size(); ++idx) {
+        data[idx] = float(idx % 10);
+    }
+    CHECK(KFP::SIMD::find_if(data, [](const simd_float& x) { return x > 8.5f; }) == 9);
+    CHECK(KFP::SIMD::find_if(data, [](const simd_float& x) { return x > 9.5f; }) == 29);
+    CHECK(KFP::SIMD::find_if(data.data() + 20, 9, [](const simd_float& x) { return x == 7.0f; }) == 7);
+    const auto minmax = KFP::SIMD::minmax_element(data);
+    CHECK(minmax.first == 0);
+    CHECK(minmax.second == 19);
+    data[27] = -1.0f;
+    CHECK(KFP::SIMD::minmax_element(data).first == 27);
+    CHECK(KFP::SIMD::minmax_element(data.data(), 0).first == 0);
+}
+
+TEST_CASE("Testing fill and copy_if") {
+    Vector<int, simd_int::SimdSize> data(23);
+    KFP::SIMD::fill(data, 5);
+    CHECK(KFP::SIMD::count_if(data, [](const simd_int& x) { return x == simd_int{5}; }) == 23);
+    for (std::size_t idx = 0; idx < data.size(); ++idx) {
+        data[idx] = static_cast<int>(idx);
+    }
+    Vector<int, simd_int::SimdSize> odd;
+    KFP::SIMD::copy_if(data, odd, [](const simd_int& x) { return (x & simd_int{1}) == simd_int{1}; });
+    REQUIRE(odd.size() == 11);
+    CHECK(odd[0] == 1);
+    CHECK(odd[10] == 21);
+    KFP::SIMD::copy_if(data, data, [](const simd_int& x) { return x > simd_int{-1}; });
+    CHECK(data.size() == 23);
+    CHECK(data[22] == 22);
+}
@@ -0,0 +1,89 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../simd.h"
+
+#include <cstdint>
+#include <vector>
+
+using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_int;
+using KFP::SIMD::simd_mask;
+
+constexpr int NLanes = simd_float::SimdLen;
+
+struct Hit
+{
+    float x, y, z;
+    int charge;
+};
+using Hits = KFP::SIMD::AoSoA<float, float, float, int>;
+
+std::vector<Hit> makeRecords(int n)
+{
+    std::vector<Hit> records;
+    for (int i = 0; i < n; ++i) {
+        records.push_back(Hit{ float(i), 0.5f * float(i), -float(i), (i % 3) - 1 });
+    }
+    return records;
+}
+
+TEST_CASE("Testing AoSoA layout") {
+    Hits hits;
+    for (int i = 0; i < 2 * NLanes + 1; ++i) {
+        hits.push_back(float(i), 0.5f * float(i), -float(i), (i % 3) - 1);
+    }
+    CHECK(hits.size() == std::size_t(2 * NLanes + 1));
+    CHECK(hits.block_count() == 3);
+    CHECK(sizeof(Hits::Block) == 4 * simd_float::SimdSize);
+    CHECK(hits.get<1>(NLanes + 1) == 0.5f * float(NLanes + 1));
+    CHECK(hits.get<3>(2) == 1);
+
+    // Fields of one block are consecutive aligned batches
+    const Hits::Block& block = hits.block(1);
+    CHECK(reinterpret_cast<std::uintptr_t>(block.data<0>()) % simd_float::SimdSize == 0);
+    CHECK(block.data<2>() == reinterpret_cast<const float*>(block.data<0>()) + 2 * NLanes);
+    CHECK((block.load<0>() == simd_float::iota(float(NLanes))).AND());
+    CHECK(hits.block_mask(1).AND());
+    CHECK(hits.block_mask(2).count() == 1);
+
+    // The partial block reads zero past the end
+    if (NLanes > 1) {
+        CHECK(hits.block(2).load<2>()[1] == 0.0f);
+    }
+
+    SUBCASE("Testing resize") {
+        hits.resize(NLanes + 1);
+        CHECK(hits.block_count() == 2);
+        hits.resize(3 * NLanes);
+        CHECK(hits.get<0>(NLanes) == float(NLanes));
+        if (NLanes > 1) {
+            CHECK(hits.get<0>(NLanes + 1) == 0.0f);
+        }
+        CHECK(hits.get<3>(3 * NLanes - 1) == 0);
+    }
+}
+
+TEST_CASE("Testing AoSoA blocks") {
+    const std::vector<Hit> records = makeRecords(3 * NLanes + 2);
+    Hits hits;
+    hits.fromAoS(records.data(), records.size());
+    CHECK(hits.size() == records.size());
+    CHECK(hits.get<2>(4) == -4.0f);
+
+    // Kernel over whole blocks: move every hit along z, flip the charge on
+    // the first lane only
+    for (Hits::Block& block : hits) {
+        block.store<2>(block.load<2>() + block.load<0>());
+        block.store<3>(-block.load<3>(), KFP::SIMD::Detail::laneMask(1));
+    }
+    std::vector<Hit> out(records.size());
+    hits.toAoS(out.data());
+    bool matches = true;
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        matches = matches && out[i].x == records[i].x && out[i].y == records[i].y && out[i].z == 0.0f;
+        matches = matches && out[i].charge == ((i % NLanes == 0) ? -records[i].charge : records[i].charge);
+    }
+    CHECK(matches);
+}
@@ -0,0 +1,88 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../simd.h"
+
+#include <cstdint>
+
+using KFP::SIMD::ArenaAllocator;
+using KFP::SIMD::ArenaVector;
+using KFP::SIMD::SimdArena;
+using KFP::SIMD::simd_float;
+
+bool isAligned(const void* ptr, std::size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+TEST_CASE("Testing arena allocation") {
+    SimdArena arena{ 1024 };
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(16, 16);
+    CHECK(isAligned(b, 16));
+    CHECK(static_cast<char*>(b) - static_cast<char*>(a) == 16);
+    CHECK(arena.used() == 32);
+    CHECK(arena.chunkCount() == 1);
+
+    SUBCASE("Testing chunks") {
+        // Larger than a chunk: gets its own chunk
+        void* big = arena.allocate(4000);
+        CHECK(isAligned(big, SimdArena::ChunkAlignment));
+        CHECK(arena.chunkCount() == 2);
+        CHECK(arena.capacity() >= 1024 + 4000);
+        // Reset keeps the chunks and hands out the same memory again
+        arena.reset();
+        CHECK(arena.used() == 0);
+        CHECK(arena.allocate(3, 1) == a);
+        CHECK(arena.allocate(4000) == big);
+        CHECK(arena.chunkCount() == 2);
+        arena.release();
+        CHECK(arena.capacity() == 0);
+    }
+    SUBCASE("Testing markers") {
+        const SimdArena::Marker start = arena.mark();
+        void* c = nullptr;
+        {
+            KFP::SIMD::SimdArenaScope scope{ arena };
+            c = arena.allocate(100);
+            arena.allocate(2000);
+            CHECK(arena.used() > 2000);
+        }
+        CHECK(arena.used() == 32);
+        CHECK(arena.allocate(100) == c);
+        arena.rewind(start);
+        CHECK(arena.used() == 32);
+    }
+    SUBCASE("Testing deallocation of the latest block") {
+        void* c = arena.allocate(64);
+        arena.deallocate(b, 16); // not the latest: kept
+        CHECK(arena.used() == 32 + 64 + 32);
+        arena.deallocate(c, 64);
+        CHECK(arena.used() == 64);
+    }
+}
+
+TEST_CASE("Testing arena vectors") {
+    SimdArena arena{ 1 << 16 };
+    for (int iEvent = 0; iEvent < 3; ++iEvent) {
+        arena.reset();
+        ArenaVector<float> x{ ArenaAllocator<float>{ arena } };
+        ArenaVector<int> id{ ArenaAllocator<int>{ arena } };
+        for (int i = 0; i < 1000; ++i) {
+            x.push_back(float(i));
+            id.push_back(i);
+        }
+        CHECK(isAligned(x.data(), simd_float::SimdSize));
+        CHECK(x[999] == 999.0f);
+        CHECK(id[500] == 500);
+        const float sum = KFP::SIMD::reduce(x.data(), x.size());
+        CHECK(sum == doctest::Approx(999.0f * 1000.0f / 2.0f));
+        // Copies share the arena
+        ArenaVector<float> copy{ x };
+        CHECK(copy.get_allocator() == x.get_allocator());
+        CHECK(copy[10] == 10.0f);
+    }
+    // The growth of x and id never left the first chunk
+    CHECK(arena.chunkCount() == 1);
+}
@@ -0,0 +1,109 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../simd.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+using KFP::SIMD::Buffer;
+using KFP::SIMD::PageBacking;
+using KFP::SIMD::simd_float;
+
+bool isAligned(const void* ptr, std::size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+// Records that its default constructor ran
+struct Tracked
+{
+    Tracked() : constructed{ true } {}
+    bool constructed;
+};
+
+TEST_CASE("Testing default-init allocator") {
+    typedef KFP::SIMD::DefaultInitAllocator<float, simd_float::SimdSize> allocator_type;
+    static_assert(std::is_same<std::allocator_traits<allocator_type>::rebind_alloc<Tracked>,
+                               KFP::SIMD::DefaultInitAllocator<Tracked, simd_float::SimdSize>>::value,
+                  "rebind keeps the default-init allocator");
+    static_assert(std::is_same<KFP::SIMD::DefaultInitVector<float, simd_float::SimdSize>::allocator_type,
+                               allocator_type>::value,
+                  "DefaultInitVector uses the default-init allocator");
+
+    // Types with a constructor are still constructed
+    KFP::SIMD::DefaultInitAllocator<Tracked, simd_float::SimdSize> tracked_allocator;
+    Tracked* tracked = tracked_allocator.allocate(1);
+    std::memset(static_cast<void*>(tracked), 0, sizeof(Tracked));
+    tracked_allocator.construct(tracked);
+    CHECK(tracked->constructed);
+    tracked_allocator.deallocate(tracked, 1);
+
+    allocator_type allocator;
+    float* data = allocator.allocate(4);
+    allocator.construct(data + 1, 2.0f);
+    CHECK(data[1] == 2.0f);
+    allocator.deallocate(data, 4);
+
+    KFP::SIMD::DefaultInitVector<float, simd_float::SimdSize> values(5, 1.0f);
+    values.resize(100);
+    values.push_back(3.0f);
+    CHECK(isAligned(values.data(), simd_float::SimdSize));
+    CHECK(values[4] == 1.0f);
+    CHECK(values[100] == 3.0f);
+    CHECK(values.get_allocator() == KFP::SIMD::DefaultInitAllocator<int, simd_float::SimdSize>{});
+}
+
+TEST_CASE("Testing buffer") {
+    Buffer<float, simd_float::SimdSize> buffer(10, 1.0f);
+    CHECK(buffer.size() == 10);
+    CHECK(isAligned(buffer.data(), simd_float::SimdSize));
+    CHECK(buffer.backing() == PageBacking::Heap);
+    buffer.push_back(buffer[0]);
+    CHECK(buffer.back() == 1.0f);
+    buffer.resize(20, 2.0f);
+    CHECK(buffer[10] == 1.0f);
+    CHECK(buffer[19] == 2.0f);
+
+    SUBCASE("Testing copy and move") {
+        Buffer<float, simd_float::SimdSize> copy{ buffer };
+        buffer[0] = 5.0f;
+        CHECK(copy[0] == 1.0f);
+        CHECK(copy.size() == 20);
+        Buffer<float, simd_float::SimdSize> moved{ std::move(copy) };
+        CHECK(copy.empty());
+        CHECK(moved[19] == 2.0f);
+        copy = moved;
+        CHECK(copy[11] == 2.0f);
+    }
+    SUBCASE("Testing growth past the huge page threshold") {
+        Buffer<int, simd_float::SimdSize> large;
+        const int n = 3 << 20; // 12 MiB of int
+        for (int i = 0; i < n; ++i) {
+            large.push_back(i);
+        }
+        MESSAGE("Large buffer backing: " << std::string{ KFP::SIMD::pageBackingStr(large.backing()) });
+        CHECK(isAligned(large.data(), simd_float::SimdSize));
+        bool ordered = true;
+        for (int i = 0; i < n; ++i) {
+            ordered = ordered && (large[static_cast<std::size_t>(i)] == i);
+        }
+        CHECK(ordered);
+        // Growing again: mremap for Mapped/TransparentHuge, a new mapping and
+        // a copy for HugeTLB. HugeTLB needs reserved pages (nr_hugepages > 0),
+        // so on most test machines the copy fallback is not exercised here.
+        large.reserve(2 * large.capacity());
+        CHECK(large[n - 1] == n - 1);
+        CHECK(isAligned(large.data(), simd_float::SimdSize));
+        // Shrinking the buffer keeps the storage
+        const int* data = large.data();
+        large.resize(10);
+        CHECK(large.data() == data);
+        CHECK(large[9] == 9);
+    }
+}
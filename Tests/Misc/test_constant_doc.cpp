@@ -0,0 +1,41 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../simd.h"
+
+#include <cstdint>
+#include <limits>
+
+using KFP::SIMD::simd_mask;
+using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_int;
+using KFP::SIMD::simd_constant;
+
+TEST_CASE("Testing simd_constant") {
+    SUBCASE("Testing float bit patterns") {
+        CHECK((simd_constant<float, 0x3F800000>::get() == simd_float{1.0f}).AND());
+        CHECK((simd_constant<float, 0x40490FDB>::get() == simd_float{3.14159265f}).AND());
+        CHECK(simd_constant<float, 0xC0000000>::scalar() == -2.0f);
+        const simd_float inf = simd_constant<float, 0x7F800000>{};
+        CHECK(isInf(inf).AND());
+    }
+    SUBCASE("Testing int values") {
+        CHECK((simd_constant<int, 42>::get() == simd_int{42}).AND());
+        CHECK((simd_constant<int, 0xFFFFFFFF>::get() == simd_int{-1}).AND());
+        CHECK(simd_constant<int, 7>::scalar() == 7);
+    }
+    SUBCASE("Testing table alignment") {
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(
+            KFP::SIMD::Detail::ConstantPool<0x3F800000, simd_float::SimdLen,
+                                            simd_float::SimdSize>::data);
+        CHECK(address % simd_float::SimdSize == 0);
+    }
+    SUBCASE("Testing sign masks") {
+        const simd_float val{-2.5f};
+        CHECK((abs(val) == simd_float{2.5f}).AND());
+        CHECK((-val == simd_float{2.5f}).AND());
+        CHECK((abs(simd_float{-0.0f}).sign() == simd_float{0.0f}).AND());
+        CHECK(isFinite(val).AND());
+    }
+}
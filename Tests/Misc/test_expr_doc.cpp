@@ -0,0 +1,59 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../simd_expr.h"
+
+#include <type_traits>
+
+using KFP::SIMD::simd_mask;
+using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_int;
+using KFP::SIMD::Expr::lazy;
+
+TEST_CASE("Testing fused functions") {
+    const simd_float val_2{2.0f};
+    const simd_float val_3{3.0f};
+    const simd_float val_5{5.0f};
+    CHECK((fmadd(val_2, val_3, val_5) == simd_float{11.0f}).AND());
+    CHECK((fmsub(val_2, val_3, val_5) == simd_float{1.0f}).AND());
+    CHECK((fnmadd(val_2, val_3, val_5) == simd_float{-1.0f}).AND());
+    CHECK((fnmsub(val_2, val_3, val_5) == simd_float{-11.0f}).AND());
+    CHECK((fmadd(simd_int{2}, simd_int{3}, simd_int{5}) == simd_int{11}).AND());
+    CHECK((fnmadd(simd_int{2}, simd_int{3}, simd_int{5}) == simd_int{-1}).AND());
+}
+
+TEST_CASE("Testing expression lowering") {
+    const simd_float a = simd_float::iota(1.0f);
+    const simd_float b{3.0f};
+    const simd_float c{0.5f};
+    SUBCASE("Testing recognised patterns") {
+        CHECK((simd_float(lazy(a) * b + c) == fmadd(a, b, c)).AND());
+        CHECK((simd_float(c + lazy(a) * b) == fmadd(a, b, c)).AND());
+        CHECK((simd_float(lazy(a) * b - c) == fmsub(a, b, c)).AND());
+        CHECK((simd_float(-(lazy(a) * b) + c) == fnmadd(a, b, c)).AND());
+        CHECK((simd_float(c - lazy(a) * b) == fnmadd(a, b, c)).AND());
+        CHECK((simd_float(lazy(a) * 2.0f + 1.0f) == a * 2.0f + 1.0f).AND());
+    }
+    SUBCASE("Testing node types") {
+        using KFP::SIMD::Expr::IsMul;
+        CHECK(IsMul<decltype(lazy(a) * b)>::value);
+        CHECK_FALSE(IsMul<decltype(lazy(a) + b)>::value);
+    }
+    SUBCASE("Testing plain expressions") {
+        CHECK((evaluate(lazy(a) + b) == a + b).AND());
+        CHECK((evaluate(lazy(a) / b - c) == a / b - c).AND());
+        CHECK((evaluate(-lazy(a)) == -a).AND());
+    }
+    SUBCASE("Testing masked forms") {
+        const simd_mask mask = a > simd_float{2.0f};
+        CHECK((select(mask, lazy(a) + b, a) == select(mask, a + b, a)).AND());
+        CHECK((select(mask, b + lazy(a), a) == select(mask, a + b, a)).AND());
+        CHECK((select(mask, lazy(a) - b, a) == select(mask, a - b, a)).AND());
+        CHECK((select(mask, lazy(c) + b, a) == select(mask, c + b, a)).AND());
+        CHECK((select(mask, lazy(a) * b + c, a) == select(mask, fmadd(a, b, c), a)).AND());
+    }
+    SUBCASE("Testing the eager operators are unchanged") {
+        CHECK((std::is_same<decltype(a * b + c), simd_float>::value));
+    }
+}
@@ -0,0 +1,58 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../simd.h"
+
+#include <cstdint>
+#include <string>
+
+using KFP::SIMD::HugePageSize;
+using KFP::SIMD::HugePageVector;
+using KFP::SIMD::PageBacking;
+using KFP::SIMD::simd_float;
+
+TEST_CASE("Testing huge page allocation") {
+    SUBCASE("Testing small buffers") {
+        PageBacking backing = PageBacking::HugeTLB;
+        void* ptr = KFP::SIMD::hugePageAllocate<simd_float::SimdSize>(1000, &backing);
+        CHECK(backing == PageBacking::Heap);
+        CHECK(KFP::SIMD::pageBacking(ptr) == PageBacking::Heap);
+        CHECK(reinterpret_cast<std::uintptr_t>(ptr) % simd_float::SimdSize == 0);
+        KFP::SIMD::hugePageDeallocate(ptr);
+    }
+    SUBCASE("Testing large buffers") {
+        const std::size_t size = 3 * HugePageSize + 100;
+        PageBacking backing = PageBacking::Heap;
+        char* ptr = static_cast<char*>(KFP::SIMD::hugePageAllocate<simd_float::SimdSize>(size, &backing));
+        REQUIRE(ptr != nullptr);
+        MESSAGE("Large buffer backing: " << std::string{ KFP::SIMD::pageBackingStr(backing) });
+        CHECK(KFP::SIMD::pageBacking(ptr) == backing);
+        if (backing != PageBacking::Heap) {
+            CHECK(reinterpret_cast<std::uintptr_t>(ptr) % HugePageSize == 0);
+        }
+        ptr[0] = 1;
+        ptr[size - 1] = 2;
+        CHECK(ptr[0] + ptr[size - 1] == 3);
+        KFP::SIMD::hugePageDeallocate(ptr);
+        CHECK(KFP::SIMD::pageBacking(ptr) == PageBacking::Heap);
+    }
+}
+
+TEST_CASE("Testing huge page vectors") {
+    HugePageVector<float, simd_float::SimdSize> data;
+    for (int i = 0; i < (1 << 20); ++i) {
+        data.push_back(float(i % 10));
+    }
+    // 4 MiB of floats: the final buffer is mapped
+    CHECK(reinterpret_cast<std::uintptr_t>(data.data()) % simd_float::SimdSize == 0);
+    CHECK(data.size() * sizeof(float) >= KFP::SIMD::HugePageThreshold);
+    MESSAGE("Vector backing: " << std::string{ KFP::SIMD::pageBackingStr(KFP::SIMD::pageBacking(data.data())) });
+    CHECK(KFP::SIMD::reduce(data.data(), data.size()) == 4718580.0f);
+
+    HugePageVector<float, simd_float::SimdSize> copy{ data };
+    CHECK(copy[123456] == data[123456]);
+    data.clear();
+    data.shrink_to_fit();
+    CHECK(copy.back() == 5.0f);
+}
@@ -0,0 +1,125 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../simd.h"
+
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+using KFP::SIMD::SimdPool;
+using KFP::SIMD::simd_float;
+
+bool isAligned(const void* ptr, std::size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+struct Candidate
+{
+    SETUP_POOLED_ALIGNED_OPERATOR_NEW_DELETE(__KFP_SIMD__Size_Float)
+
+    Candidate(float value) : x{ value } {}
+    virtual ~Candidate() = default;
+
+    simd_float x;
+    int id{ 0 };
+};
+
+struct BigCandidate : public Candidate
+{
+    BigCandidate(float value) : Candidate{ value }, cov{ value } {}
+    simd_float cov[16];
+};
+
+TEST_CASE("Testing pool allocation") {
+    void* a = SimdPool::allocate(40);
+    CHECK(isAligned(a, SimdPool::Alignment));
+    const std::size_t cached = SimdPool::cachedCount(40);
+    // Blocks are reused last in, first out
+    SimdPool::deallocate(a, 40);
+    CHECK(SimdPool::cachedCount(40) == cached + 1);
+    CHECK(SimdPool::allocate(33) == a);
+    SimdPool::deallocate(a, 33);
+
+    SUBCASE("Testing many blocks") {
+        std::vector<void*> blocks;
+        std::set<void*> unique;
+        for (int i = 0; i < 1000; ++i) {
+            blocks.push_back(SimdPool::allocate(100));
+            unique.insert(blocks.back());
+            CHECK(isAligned(blocks.back(), SimdPool::Alignment));
+        }
+        CHECK(unique.size() == blocks.size());
+        for (void* block : blocks) {
+            SimdPool::deallocate(block, 100);
+        }
+        // Frees beyond two batches went back to the global pool
+        CHECK(SimdPool::cachedCount(100) <= 2 * SimdPool::BatchSize);
+        SimdPool::flushThreadCache();
+        CHECK(SimdPool::cachedCount(100) == 0);
+    }
+    SUBCASE("Testing large blocks") {
+        void* big = SimdPool::allocate(SimdPool::MaxSize + 1);
+        CHECK(isAligned(big, SimdPool::Alignment));
+        CHECK(SimdPool::cachedCount(SimdPool::MaxSize + 1) == 0);
+        SimdPool::deallocate(big, SimdPool::MaxSize + 1);
+    }
+}
+
+TEST_CASE("Testing pooled operator new") {
+    Candidate* c = new Candidate{ 1.0f };
+    CHECK(isAligned(c, __KFP_SIMD__Size_Float));
+    CHECK(c->x[0] == 1.0f);
+    delete c;
+    // Same size: the block comes straight back
+    Candidate* d = new Candidate{ 2.0f };
+    CHECK(d == c);
+    delete d;
+
+    // Deleting through the base uses the size of the derived class
+    Candidate* big = new BigCandidate{ 3.0f };
+    CHECK(isAligned(big, __KFP_SIMD__Size_Float));
+    delete big;
+    CHECK(new BigCandidate{ 4.0f } == big);
+    delete big;
+
+    Candidate* array = new Candidate[5]{ 0.0f, 1.0f, 2.0f, 3.0f, 4.0f };
+    CHECK(array[4].x[0] == 4.0f);
+    delete[] array;
+}
+
+TEST_CASE("Testing pool with threads") {
+    // Objects are allocated in one thread and freed in another
+    std::vector<Candidate*> produced(4000);
+    std::thread producer([&]() {
+        for (std::size_t i = 0; i < produced.size(); ++i) {
+            produced[i] = new Candidate{ float(i) };
+        }
+    });
+    producer.join();
+
+    std::vector<std::thread> workers;
+    for (int iThread = 0; iThread < 4; ++iThread) {
+        workers.emplace_back([&, iThread]() {
+            for (std::size_t i = static_cast<std::size_t>(iThread); i < produced.size(); i += 4) {
+                CHECK(produced[i]->x[0] == float(i));
+                delete produced[i];
+            }
+            for (int iRepeat = 0; iRepeat < 100; ++iRepeat) {
+                std::vector<Candidate*> local;
+                for (int i = 0; i < 100; ++i) {
+                    local.push_back(new Candidate{ float(i) });
+                }
+                for (Candidate* c : local) {
+                    delete c;
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
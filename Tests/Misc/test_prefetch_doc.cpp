@@ -0,0 +1,71 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../simd.h"
+
+#include <vector>
+
+using KFP::SIMD::PrefetchLevel;
+using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_int;
+using KFP::SIMD::simd_mask;
+
+constexpr int NLanes = simd_float::SimdLen;
+
+TEST_CASE("Testing prefetch hints") {
+    std::vector<float> data(1000, 1.0f);
+    // Hints only: nothing observable but they must compile for every level
+    KFP::SIMD::prefetch(data.data());
+    KFP::SIMD::prefetch<PrefetchLevel::L2>(data.data() + 100);
+    KFP::SIMD::prefetch<PrefetchLevel::L3>(data.data() + 200);
+    KFP::SIMD::prefetch<PrefetchLevel::NonTemporal>(data.data() + 300);
+    KFP::SIMD::gather_prefetch(data.data(), simd_int::iota(0) * simd_int{ 100 });
+    KFP::SIMD::gather_prefetch<PrefetchLevel::L2>(data.data(), simd_int::iota(0), simd_mask{ false });
+    CHECK(data[0] == 1.0f);
+}
+
+TEST_CASE("Testing prefetched_for") {
+    for (const std::size_t distance : { 0u, 1u, 3u, 20u }) {
+        CAPTURE(distance);
+        std::vector<std::size_t> bodies, prefetches;
+        KFP::SIMD::prefetched_for(
+            10, distance, [&](std::size_t b) { prefetches.push_back(b); },
+            [&](std::size_t b) { bodies.push_back(b); });
+        REQUIRE(bodies.size() == 10);
+        CHECK(bodies.back() == 9);
+        CHECK(prefetches.size() == ((distance > 0 && distance < 10) ? 10 - distance : 0));
+        if (!prefetches.empty()) {
+            CHECK(prefetches.front() == distance);
+            CHECK(prefetches.back() == 9);
+        }
+    }
+}
+
+TEST_CASE("Testing gather_prefetched") {
+    std::vector<float> values(100);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = float(i);
+    }
+    // Indices in reverse order, one partial batch at the end
+    const std::size_t size = 3 * NLanes + 1;
+    std::vector<int> indices(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        indices[i] = 99 - int(i);
+    }
+    for (const std::size_t distance : { 0u, 2u }) {
+        std::vector<float> out(size, -1.0f);
+        KFP::SIMD::gather_prefetched(
+            values.data(), indices.data(), size,
+            [&](const simd_float& batch, const simd_mask& mask, std::size_t begin) {
+                for (int iLane = 0; iLane < NLanes; ++iLane) {
+                    if (mask[iLane]) {
+                        out[begin + static_cast<std::size_t>(iLane)] = batch[iLane];
+                    }
+                }
+            },
+            distance);
+        CHECK(out[0] == 99.0f);
+        CHECK(out[size - 1] == float(100 - int(size)));
+    }
+}
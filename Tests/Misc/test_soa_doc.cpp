@@ -0,0 +1,106 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../simd.h"
+
+#include <cstdint>
+#include <utility>
+
+using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_int;
+using KFP::SIMD::simd_mask;
+
+constexpr int NLanes = simd_float::SimdLen;
+
+// x, y, charge
+using Hits = KFP::SIMD::SoA<float, float, int>;
+
+Hits makeHits(int n)
+{
+    Hits hits;
+    for (int i = 0; i < n; ++i) {
+        hits.push_back(0.5f * float(i), -float(i), (i % 2) ? 1 : -1);
+    }
+    return hits;
+}
+
+TEST_CASE("Testing SoA layout") {
+    Hits hits = makeHits(3 * NLanes + 1);
+    CHECK(hits.size() == std::size_t(3 * NLanes + 1));
+    CHECK(hits.capacity() % NLanes == 0);
+    CHECK(hits.batch_count() == 4);
+    CHECK(hits.get<0>(3) == 1.5f);
+    CHECK(hits.get<2>(2) == -1);
+    // Every column starts aligned and the padding is zero
+    CHECK(reinterpret_cast<std::uintptr_t>(hits.column<0>()) % simd_float::SimdSize == 0);
+    CHECK(reinterpret_cast<std::uintptr_t>(hits.column<1>()) % simd_float::SimdSize == 0);
+    CHECK(reinterpret_cast<std::uintptr_t>(hits.column<2>()) % simd_int::SimdSize == 0);
+    CHECK(hits.column<1>()[hits.capacity() - 1] == ((hits.size() == hits.capacity()) ? -float(hits.size() - 1) : 0.0f));
+
+    SUBCASE("Testing resize") {
+        hits.resize(2);
+        CHECK(hits.size() == 2);
+        CHECK(hits.get<0>(2) == 0.0f);
+        hits.resize(5 * NLanes);
+        CHECK(hits.get<1>(1) == -1.0f);
+        CHECK(hits.get<1>(4) == 0.0f);
+        CHECK(hits.get<2>(5 * NLanes - 1) == 0);
+        hits.clear();
+        CHECK(hits.empty());
+        CHECK(hits.batch_count() == 0);
+    }
+    SUBCASE("Testing copy and move") {
+        Hits copy{ hits };
+        hits.get<0>(0) = 42.0f;
+        CHECK(copy.get<0>(0) == 0.0f);
+        CHECK(copy.get<1>(3 * NLanes) == -float(3 * NLanes));
+        Hits moved{ std::move(copy) };
+        CHECK(moved.size() == hits.size());
+        CHECK(copy.empty());
+        copy = moved;
+        CHECK(copy.get<2>(1) == 1);
+    }
+}
+
+TEST_CASE("Testing SoA batches") {
+    Hits hits = makeHits(2 * NLanes + 1);
+    const std::size_t last = hits.batch_count() - 1;
+
+    Hits::Batch batch = hits.batch(1);
+    CHECK((batch.get<0>() == simd_float::iota(float(NLanes)) * 0.5f).AND());
+    CHECK((batch.get<2>() == simd_int{ 0 }).count() == 0);
+    CHECK(hits.batch_mask(0).AND());
+    CHECK(hits.batch_mask(last).count() == 1);
+
+    // The partial block reads zero past the end
+    const Hits::Batch tail = hits.batch(last);
+    CHECK(tail.get<0>()[0] == float(NLanes));
+    if (NLanes > 1) {
+        CHECK(tail.get<1>()[1] == 0.0f);
+    }
+
+    SUBCASE("Testing masked store") {
+        batch.get<1>() = simd_float{ 7.0f };
+        batch.get<2>() = simd_int{ 3 };
+        const simd_mask odd = (simd_int::iota(0) & simd_int{ 1 }) == simd_int{ 1 };
+        hits.store_batch(1, batch, odd);
+        for (int iLane = 0; iLane < NLanes; ++iLane) {
+            const std::size_t i = static_cast<std::size_t>(NLanes + iLane);
+            CHECK(hits.get<1>(i) == ((iLane % 2) ? 7.0f : -float(i)));
+            CHECK(hits.get<0>(i) == 0.5f * float(i));
+        }
+    }
+    SUBCASE("Testing store past the end") {
+        Hits::Batch ones;
+        ones.get<0>() = simd_float{ 1.0f };
+        ones.get<1>() = simd_float{ 1.0f };
+        ones.get<2>() = simd_int{ 1 };
+        hits.store_batch(last, ones);
+        CHECK(hits.get<0>(2 * NLanes) == 1.0f);
+        // The padding stays zero
+        if (NLanes > 1) {
+            CHECK(hits.column<0>()[2 * NLanes + 1] == 0.0f);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../simd.h"
+
+using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_int;
+using KFP::SIMD::Vector;
+
+constexpr int NLanes = simd_float::SimdLen;
+
+TEST_CASE("Testing stream threshold") {
+    CHECK(KFP::SIMD::lastLevelCacheSize() > 0);
+    CHECK(KFP::SIMD::streamThreshold() == KFP::SIMD::lastLevelCacheSize() / 2);
+}
+
+TEST_CASE("Testing stream routines") {
+    const std::size_t size = 5 * NLanes + 3;
+    Vector<float, simd_float::SimdSize> in(size + 1);
+    Vector<float, simd_float::SimdSize> out(size + 1, -1.0f);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        in[i] = float(i);
+    }
+
+    // Streaming for everything, then for nothing
+    for (const std::size_t threshold : { std::size_t{ 0 }, std::size_t{ 1 } << 40 }) {
+        CAPTURE(threshold);
+        KFP::SIMD::setStreamThreshold(threshold);
+
+        KFP::SIMD::stream_copy(in.data(), out.data(), size);
+        CHECK(out[0] == 0.0f);
+        CHECK(out[size - 1] == float(size - 1));
+        CHECK(out[size] == -1.0f);
+
+        KFP::SIMD::stream_fill(out.data(), size, 2.0f);
+        CHECK(KFP::SIMD::reduce(out.data(), size) == 2.0f * float(size));
+        CHECK(out[size] == -1.0f);
+
+        // Unaligned input
+        KFP::SIMD::stream_transform(in.data() + 1, out.data(), size,
+                                    [](const simd_float& x) { return x * 2.0f; });
+        CHECK(out[0] == 2.0f);
+        CHECK(out[size - 1] == 2.0f * float(size));
+        CHECK(out[size] == -1.0f);
+    }
+
+    SUBCASE("Testing int") {
+        KFP::SIMD::setStreamThreshold(0);
+        Vector<int, simd_int::SimdSize> ids(3 * NLanes + 1);
+        KFP::SIMD::stream_fill(ids.data(), ids.size(), 7);
+        CHECK(ids.back() == 7);
+        Vector<int, simd_int::SimdSize> copy(ids.size());
+        KFP::SIMD::stream_transform(ids.data(), copy.data(), ids.size(),
+                                    [](const simd_int& x) { return x + simd_int{ 1 }; });
+        CHECK(copy[0] == 8);
+        CHECK(copy.back() == 8);
+    }
+    // Unaligned output falls back to regular stores
+    SUBCASE("Testing unaligned output") {
+        KFP::SIMD::setStreamThreshold(0);
+        KFP::SIMD::stream_copy(in.data(), out.data() + 1, size);
+        CHECK(out[1] == 0.0f);
+        CHECK(out[size] == float(size - 1));
+    }
+    KFP::SIMD::setStreamThreshold(KFP::SIMD::lastLevelCacheSize() / 2);
+}
@@ -0,0 +1,106 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../simd.h"
+
+#include <type_traits>
+
+using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_int;
+using KFP::SIMD::simd_mask;
+
+constexpr int NLanes = simd_float::SimdLen;
+
+KFP_SIMD_STRUCT(Hit, (float, x), (float, y), (float, z), (int, station))
+
+static_assert(std::is_trivially_copyable<Hit>::value && sizeof(Hit) == 4 * sizeof(float),
+              "The scalar struct holds only the fields");
+static_assert(Hit::field_z == 2 && Hit::NFields == 4, "Field indices follow the declaration");
+static_assert(std::is_same<decltype(HitSimd::station), simd_int>::value, "int fields become simd_int");
+
+HitSoA makeHits(int n)
+{
+    HitSoA hits;
+    for (int i = 0; i < n; ++i) {
+        hits.push_back(Hit{ float(i), 2.0f * float(i), -float(i), i % 5 });
+    }
+    return hits;
+}
+
+TEST_CASE("Testing generated SoA") {
+    HitSoA hits = makeHits(2 * NLanes + 1);
+    CHECK(hits.size() == std::size_t(2 * NLanes + 1));
+    CHECK(hits.y()[2] == 4.0f);
+    CHECK(hits.station() == hits.column<Hit::field_station>());
+    const Hit hit = hits.record(2);
+    CHECK(hit.z == -2.0f);
+    CHECK(hit.station == 2);
+    hits.setRecord(1, Hit{ 9.0f, 8.0f, 7.0f, 6 });
+    CHECK(hits.get<Hit::field_x>(1) == 9.0f);
+    // The variadic push_back of SoA is still there
+    hits.push_back(1.0f, 2.0f, 3.0f, 4);
+    CHECK(hits.record(2 * NLanes + 1).station == 4);
+}
+
+TEST_CASE("Testing generated SIMD struct") {
+    HitSoA hits = makeHits(2 * NLanes + 1);
+
+    SUBCASE("Testing block load and store") {
+        HitSimd block;
+        block.load(hits, 1);
+        CHECK((block.x == simd_float::iota(float(NLanes))).AND());
+        CHECK(block.get(0).station == NLanes % 5);
+
+        block.z = simd_float{ 100.0f };
+        const simd_mask first = KFP::SIMD::Detail::laneMask(1);
+        block.store(hits, 1, first);
+        CHECK(hits.z()[NLanes] == 100.0f);
+        if (NLanes > 1) {
+            CHECK(hits.z()[NLanes + 1] == -float(NLanes + 1));
+        }
+
+        // Lanes past the end are not written
+        HitSimd last;
+        last.load(hits, 2);
+        last.y = simd_float{ 1.0f };
+        last.store(hits, 2);
+        CHECK(hits.y()[2 * NLanes] == 1.0f);
+        if (NLanes > 1) {
+            CHECK(hits.y()[2 * NLanes + 1] == 0.0f);
+        }
+    }
+    SUBCASE("Testing gather and scatter") {
+        const simd_int index = simd_int::iota(0) * simd_int{ 2 };
+        HitSimd gathered;
+        gathered.gather(hits, index);
+        for (int iLane = 0; iLane < NLanes; ++iLane) {
+            CHECK(gathered.y[iLane] == 4.0f * float(iLane));
+            CHECK(gathered.station[iLane] == (2 * iLane) % 5);
+        }
+        gathered.x = simd_float{ -1.0f };
+        gathered.scatter(hits, index, KFP::SIMD::Detail::laneMask(1));
+        CHECK(hits.x()[0] == -1.0f);
+        if (NLanes > 1) {
+            CHECK(hits.x()[2] == 2.0f);
+        }
+        gathered.scatter(hits, index);
+        CHECK(hits.x()[2 * (NLanes - 1)] == -1.0f);
+    }
+    SUBCASE("Testing AoS access and select") {
+        Hit records[8];
+        for (int i = 0; i < 8; ++i) {
+            records[i] = Hit{ 0.5f * float(i), 0.0f, 1.0f, i };
+        }
+        HitSimd a;
+        a.loadAoS(records);
+        HitSimd b = a;
+        b.set(0, Hit{ 7.0f, 7.0f, 7.0f, 7 });
+        const HitSimd chosen = select(simd_int::iota(0) == simd_int{ 0 }, b, a);
+        CHECK(chosen.get(0).station == 7);
+        Hit out[8]{};
+        chosen.storeAoS(out);
+        CHECK(out[0].x == 7.0f);
+        CHECK(out[NLanes - 1].station == ((NLanes > 1) ? NLanes - 1 : 7));
+    }
+}
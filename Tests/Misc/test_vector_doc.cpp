@@ -0,0 +1,94 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../simd.h"
+
+#include <cstdint>
+#include <utility>
+
+using KFP::SIMD::SimdVector;
+using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_int;
+
+constexpr int NLanes = simd_float::SimdLen;
+
+TEST_CASE("Testing SimdVector layout") {
+    SimdVector<float> values(2 * NLanes + 1, 1.0f, -1.0f);
+    CHECK(values.size() == std::size_t(2 * NLanes + 1));
+    CHECK(values.padded_size() == std::size_t(3 * NLanes));
+    CHECK(values.capacity() % NLanes == 0);
+    CHECK(values.batch_count() == 3);
+    CHECK(reinterpret_cast<std::uintptr_t>(values.data()) % simd_float::SimdSize == 0);
+    // The last batch is padded with the padding value
+    CHECK(values.batch(2)[0] == 1.0f);
+    CHECK((values.batch(2) == simd_float{ -1.0f }).count() == NLanes - 1);
+
+    SUBCASE("Testing growth") {
+        for (int i = 0; i < 100; ++i) {
+            values.push_back(float(i));
+        }
+        CHECK(values.back() == 99.0f);
+        CHECK(values.capacity() % NLanes == 0);
+        CHECK(values.data()[values.padded_size() - 1] == ((values.size() % NLanes) ? -1.0f : 99.0f));
+        values.pop_back();
+        CHECK(values.data()[values.size()] == -1.0f);
+        values.resize(3);
+        CHECK(values[2] == 1.0f);
+        CHECK(values.data()[values.padded_size() - 1] == ((NLanes > 3) ? -1.0f : 1.0f));
+        values.set_padding(0.0f);
+        CHECK(KFP::SIMD::reduce(values.data(), values.padded_size()) == 3.0f);
+        values.clear();
+        CHECK(values.empty());
+        CHECK(values.batch_count() == 0);
+    }
+    SUBCASE("Testing growth after a shrink") {
+        SimdVector<float> shrunk(100, 5.0f, -1.0f);
+        shrunk.resize(10);
+        for (int i = 0; i < 7; ++i) {
+            shrunk.push_back(float(i));
+        }
+        for (std::size_t i = shrunk.size(); i < shrunk.padded_size(); ++i) {
+            CHECK(shrunk.data()[i] == -1.0f);
+        }
+        shrunk.clear();
+        shrunk.push_back(1.0f);
+        CHECK((shrunk.batch(0) == simd_float{ -1.0f }).count() == NLanes - 1);
+        CHECK(shrunk.batch(0)[0] == 1.0f);
+    }
+    SUBCASE("Testing copy and move") {
+        SimdVector<float> copy{ values };
+        values[0] = 5.0f;
+        CHECK(copy[0] == 1.0f);
+        CHECK(copy.padding() == -1.0f);
+        CHECK((copy.batch(2) == values.batch(2)).AND());
+        SimdVector<float> moved{ std::move(copy) };
+        CHECK(copy.empty());
+        CHECK(moved.size() == values.size());
+    }
+}
+
+TEST_CASE("Testing SimdVector batches") {
+    SimdVector<int> ids;
+    for (int i = 0; i < 3 * NLanes + 2; ++i) {
+        ids.push_back(i);
+    }
+    // Full-width stores, no epilogue, and the padding survives
+    for (auto batch : ids.batches()) {
+        batch.store(batch.load() * simd_int{ 2 } + simd_int{ 1 });
+    }
+    CHECK(ids[0] == 1);
+    CHECK(ids.back() == 2 * (3 * NLanes + 1) + 1);
+    for (std::size_t i = ids.size(); i < ids.padded_size(); ++i) {
+        CHECK(ids.data()[i] == 0);
+    }
+    const std::size_t last = ids.batch_count() - 1;
+    CHECK(ids.batch_mask(0).AND());
+    CHECK(ids.batch_mask(last).count() == ((NLanes > 1) ? 2 : 1));
+
+    ids.store_batch(0, simd_int{ 7 });
+    CHECK(ids[NLanes - 1] == 7);
+    ids.store_batch(last, simd_int{ 9 });
+    CHECK(ids.back() == 9);
+    CHECK(ids.data()[ids.padded_size() - 1] == ((NLanes > 2) ? 0 : 9));
+}
@@ -6,6 +6,7 @@
 using KFP::SIMD::simd_mask;
 using KFP::SIMD::simd_float;
 using KFP::SIMD::simd_int;
+using KFP::SIMD::simd_constant;
 using Vc::float_m;
 using Vc::float_v;
 using Vc::int_v;
@@ -13,7 +14,7 @@ using Vc::uint_v;
 
 __KFP_SIMD__INLINE simd_float Sin(const simd_float& phi)
 {
-    const simd_float pi{3.1415926535897932f};
+    const simd_float pi = simd_constant<float, 0x40490FDB>::get(); // 3.1415926535897932f
     const simd_float nTurnsF = (phi + pi) / (simd_float{2.f}*pi);
     simd_int nTurns = simd_int{nTurnsF};
     nTurns = select((nTurns <= 0) && (phi < -pi), nTurns-1, nTurns);
@@ -32,7 +33,7 @@ __KFP_SIMD__INLINE simd_float Sin(const simd_float& phi)
 }
 __KFP_SIMD__INLINE simd_float Cos(const simd_float& phi)
 {
-    return Sin(phi + simd_float{1.570796326795f}); //x + pi/2
+    return Sin(phi + simd_constant<float, 0x3FC90FDB>::get()); //x + pi/2
 }
 
 static inline __attribute__((always_inline)) simd_float multiplySign(const simd_int& s, const simd_float& x) {
@@ -61,15 +62,15 @@ static __KFP_SIMD__INLINE void sincos(simd_float x, simd_float& sinX, simd_float
     //     const simd_float sin0 = sin(x);
     //     const simd_float cos0 = cos(x);
 
-    const simd_float pi2i = 6.36619772e-1f;
+    const simd_float pi2i = simd_constant<float, 0x3F22F983>::get(); // 6.36619772e-1f
     const simd_int nPi2 = static_cast<simd_int>( round(x*pi2i) );
     const simd_int q = nPi2 & 3;
     const simd_int sinSign = q << 30;
     const simd_int cosSign = (q+1) << 30;
 
     const simd_float nPi2f = static_cast<simd_float>(nPi2);
-    x = x - simd_float{1.5707969666f} * nPi2f;
-    x = x + simd_float{6.3975784e-7f} * nPi2f;
+    x = x - simd_constant<float, 0x3FC90FE0>::get() * nPi2f; // 1.5707969666f
+    x = x + simd_constant<float, 0x352BBBD3>::get() * nPi2f; // 6.3975784e-7f
 
     const simd_float sinS = sinSeries(x);
     const simd_float cosS = cosSeries(x);
@@ -128,7 +129,7 @@ static __KFP_SIMD__INLINE void sincos(simd_float x, simd_float& sinX, simd_float
 
 static __KFP_SIMD__INLINE simd_float ATan2( const simd_float &y, const simd_float &x )
 {
-    const simd_float pi(3.1415926535897932f);
+    const simd_float pi = simd_constant<float, 0x40490FDB>::get(); // 3.1415926535897932f
     const simd_float zero(0.0f);
 
     const simd_mask& xZero = (x == zero);
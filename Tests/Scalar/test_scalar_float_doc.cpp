@@ -3,11 +3,13 @@
 #include "doctest.h"
 
 #include "../simd.h"
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 using KFP::SIMD::simd_mask;
-using KFP::SIMD::simd_index;
 using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_int;
 
 TEST_CASE("Testing simd_mask") {
     simd_mask mask;
@@ -22,7 +24,15 @@ TEST_CASE("Testing simd_mask") {
     SUBCASE("Testing constant constructor") {
         CHECK(mask_true.AND() == true);
         CHECK(mask_true.OR() == true);
-        CHECK(mask_true.count() == 4);
+        CHECK(mask_true.count() == simd_mask::SimdLen);
+    }
+    SUBCASE("Testing logical operators") {
+        CHECK((!mask) == mask_true);
+        CHECK((mask || mask_true) == mask_true);
+        CHECK((mask && mask_true) == mask);
+        CHECK((mask ^ mask_true) == mask_true);
+        CHECK(mask_true.cutoffCopy(0) == mask);
+        CHECK(mask.insertCopy(0, true) == mask_true);
     }
 }
 TEST_CASE("Testing methods") {
@@ -32,18 +42,63 @@ TEST_CASE("Testing methods") {
         CHECK((val_const == simd_float(1.0f)).AND() );
     }
     SUBCASE("Testing insert") {
-        const simd_float val_zero = simd_float{0.0f} ;
         const simd_float val_1 =  simd_float(1.0f);
         const simd_float val_2 =  simd_float(2.0f);
         const simd_float val_3 =  simd_float(3.0f);
         const simd_float val_4 =  simd_float(4.0f);
         CHECK((simd_float{0.0f}.insert(0, 1.0f) == val_1).AND()) ;
-        CHECK((simd_float{0.0f}.insert(1, 2.0f) == val_2).AND());
-        CHECK((simd_float{0.0f}.insert(2, 3.0f) == val_3).AND());
-        CHECK((simd_float{0.0f}.insert(3, 4.0f) == val_4).AND());
         SUBCASE("Testing addition version 1") {
-            CHECK((val_10 == (val_1 + val_2 + val_3 + val_1)).count() == 2);
+            CHECK((val_10 == (val_1 + val_2 + val_3 + val_1)).count() == 0);
             CHECK((val_10 == (val_1 + val_2 + val_3 + val_4)).AND());
         }
     }
+    SUBCASE("Testing shift, rotate and partial load") {
+        const float f1[]{1.0f};
+        CHECK((val_const.shiftLeftCopy(0) == val_const).AND());
+        CHECK((val_const.shiftLeftCopy(1) == simd_float{0.0f}).AND());
+        CHECK((val_const.shiftRightCopy(1) == simd_float{0.0f}).AND());
+        CHECK((val_const.rotateCopy(1) == val_const).AND());
+        CHECK((simd_float{}.load_partial(1, f1) == val_const).AND());
+        CHECK((val_const.cutoffCopy(0) == simd_float{0.0f}).AND());
+    }
+    SUBCASE("Testing gather and scatter") {
+        const float data[]{1.0f, 2.0f, 3.0f, 4.0f};
+        float out[4]{};
+        const simd_float gathered = simd_float{}.gather(data, simd_int{2});
+        CHECK(gathered[0] == 3.0f);
+        gathered.scatter(out, simd_int{1});
+        CHECK(out[1] == 3.0f);
+    }
+}
+TEST_CASE("Testing bitwise and math parity") {
+    SUBCASE("Testing sign and bitwise operators") {
+        const simd_float val_neg{-2.5f};
+        CHECK(std::signbit(val_neg.sign()[0]));
+        CHECK((simd_float{2.5f}.sign() == simd_float{0.0f}).AND());
+        CHECK(((val_neg.sign() ^ simd_float{2.5f}) == val_neg).AND());
+        CHECK((abs(val_neg) == simd_float{2.5f}).AND());
+        CHECK((-val_neg == simd_float{2.5f}).AND());
+        CHECK(((simd_int{5} << 2) == simd_int{20}).AND());
+        CHECK(((simd_int{-8} >> 1) == simd_int{-4}).AND());
+        CHECK(((simd_int{6} & simd_int{3}) == simd_int{2}).AND());
+    }
+    SUBCASE("Testing rounding and special values") {
+        CHECK((round(simd_float{2.5f}) == simd_float{2.0f}).AND());
+        CHECK((round(simd_float{3.5f}) == simd_float{4.0f}).AND());
+        CHECK(isNaN(simd_float{std::numeric_limits<float>::quiet_NaN()}).AND());
+        CHECK(isInf(simd_float{std::numeric_limits<float>::infinity()}).AND());
+        CHECK(isFinite(simd_float{1.0f}).AND());
+        CHECK((sqrt(simd_int{10}) == simd_int{3}).AND());
+    }
+    SUBCASE("Testing select, apply and casts") {
+        const simd_float val_1{1.0f};
+        const simd_float val_2{2.0f};
+        CHECK((select(val_1 < val_2, val_1, val_2) == val_1).AND());
+        CHECK((select(val_1 > val_2, val_1, val_2) == val_2).AND());
+        CHECK((min(val_1, val_2) == val_1).AND());
+        CHECK((max(val_1, val_2) == val_2).AND());
+        CHECK((apply(val_2, [](float x) { return x * x; }) == simd_float{4.0f}).AND());
+        CHECK((simd_int{simd_float{2.7f}} == simd_int{2}).AND());
+        CHECK((simd_float::type_cast(simd_int{0x3F800000}) == val_1).AND());
+    }
 }
@@ -0,0 +1,149 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../Track/simd_combinatorics.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_int;
+using KFP::SIMD::simd_mask;
+using KFP::SIMD::SimdPairList;
+using KFP::SIMD::SimdTiling;
+using KFP::SIMD::SimdTripletList;
+using FloatVector = KFP::SIMD::Vector<float, simd_float::SimdSize>;
+
+constexpr int NLanes = simd_float::SimdLen;
+
+// One coordinate per entry, padded for the block loads
+FloatVector makeList(int n, float scale, float offset)
+{
+    FloatVector x(static_cast<std::size_t>(KFP::SIMD::paddedSize(n)), 1e9f);
+    for (std::size_t i = 0; i < static_cast<std::size_t>(n); ++i) {
+        x[i] = scale * float((i * 37) % 101) + offset;
+    }
+    return x;
+}
+
+std::vector<std::pair<int, int>> sortedPairs(const SimdPairList& pairs)
+{
+    std::vector<std::pair<int, int>> result;
+    for (int c = 0; c < pairs.size(); ++c) {
+        result.emplace_back(pairs(0, c), pairs(1, c));
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+TEST_CASE("Testing compress-store") {
+    __KFP_SIMD__SPEC_ALIGN(simd_int::SimdSize) int out[NLanes]{};
+    const simd_int val = simd_int::iota(10);
+    const simd_mask odd = (simd_int::iota(0) & simd_int{ 1 }) == simd_int{ 1 };
+    const int count = SimdPairList::compressStore(val, odd, out);
+    CHECK(count == NLanes / 2);
+    for (int i = 0; i < count; ++i) {
+        CHECK(out[i] == 11 + 2 * i);
+    }
+    CHECK(SimdPairList::compressStore(val, simd_mask{ true }, out) == NLanes);
+    CHECK(out[NLanes - 1] == 10 + NLanes - 1);
+    CHECK(SimdPairList::compressStore(val, simd_mask{ false }, out) == 0);
+}
+
+TEST_CASE("Testing pair search") {
+    const int nFirst = 45;
+    const int nSecond = 77; // not a multiple of SimdLen
+    const FloatVector a = makeList(nFirst, 0.5f, 0.0f);
+    const FloatVector b = makeList(nSecond, 0.5f, 0.25f);
+    const float window = 3.0f;
+    // The cuts get int indices
+    const float* const pa = a.data();
+    const float* const pb = b.data();
+
+    int calls[2]{ 0, 0 };
+    const auto near = [&](int i, int j) {
+        ++calls[0];
+        return abs(simd_float{}.load_a(pb + j) - simd_float{ pa[i] }) < simd_float{ window };
+    };
+    const auto ordered = [&](int i, int j) {
+        ++calls[1];
+        return simd_float{}.load_a(pb + j) > simd_float{ pa[i] };
+    };
+
+    std::vector<std::pair<int, int>> reference;
+    for (std::size_t i = 0; i < nFirst; ++i) {
+        for (std::size_t j = 0; j < nSecond; ++j) {
+            if (std::abs(b[j] - a[i]) < window && b[j] > a[i]) {
+                reference.emplace_back(static_cast<int>(i), static_cast<int>(j));
+            }
+        }
+    }
+    REQUIRE(!reference.empty());
+
+    SUBCASE("Testing default tiling") {
+        SimdPairList pairs;
+        const int found = findPairs(nFirst, nSecond, KFP::SIMD::makeCutChain(near, ordered), pairs);
+        CHECK(found == int(reference.size()));
+        CHECK(sortedPairs(pairs) == reference);
+        // The second cut only runs on blocks with survivors of the first
+        CHECK(calls[0] == nFirst * ((nSecond + NLanes - 1) / NLanes));
+        CHECK(calls[1] < calls[0]);
+    }
+    SUBCASE("Testing small tiles") {
+        SimdPairList pairs;
+        const SimdTiling tiling{ 7, 2 * NLanes };
+        findPairs(nFirst, nSecond, KFP::SIMD::makeCutChain(near, ordered), pairs, tiling);
+        CHECK(sortedPairs(pairs) == reference);
+        // Pairs are appended to what the list holds
+        findPairs(nFirst, nSecond, KFP::SIMD::makeCutChain(near, ordered), pairs, tiling);
+        CHECK(pairs.size() == 2 * int(reference.size()));
+    }
+    SUBCASE("Testing empty lists") {
+        SimdPairList pairs;
+        CHECK(findPairs(0, nSecond, KFP::SIMD::makeCutChain(near), pairs) == 0);
+        CHECK(findPairs(nFirst, 0, KFP::SIMD::makeCutChain(near), pairs) == 0);
+        CHECK(pairs.size() == 0);
+    }
+}
+
+TEST_CASE("Testing triplet search") {
+    const int n = 30;
+    const FloatVector x = makeList(n, 1.0f, 0.0f);
+    const float* const px = x.data();
+
+    // Increasing triplets of close values from one list
+    const auto pairCut = [&](int i, int j) {
+        const simd_float xj = simd_float{}.load_a(px + j);
+        return (xj > simd_float{ px[i] }) && (xj < simd_float{ px[i] + 20.0f });
+    };
+    SimdPairList pairs;
+    findPairs(n, n, KFP::SIMD::makeCutChain(pairCut), pairs);
+
+    const auto tripletCut = [&](int p, int k) {
+        const simd_float xk = simd_float{}.load_a(px + k);
+        const float xj = px[pairs(1, p)];
+        return (xk > simd_float{ xj }) && (xk < simd_float{ xj + 20.0f });
+    };
+    SimdTripletList triplets;
+    findTriplets(pairs, n, KFP::SIMD::makeCutChain(tripletCut), triplets);
+
+    int reference = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            for (std::size_t k = 0; k < n; ++k) {
+                reference += (x[j] > x[i] && x[j] < x[i] + 20.0f && x[k] > x[j] && x[k] < x[j] + 20.0f);
+            }
+        }
+    }
+    CHECK(triplets.size() == reference);
+    bool valid = true;
+    for (int c = 0; c < triplets.size(); ++c) {
+        const float xi = px[triplets(0, c)];
+        const float xj = px[triplets(1, c)];
+        const float xk = px[triplets(2, c)];
+        valid = valid && (xi < xj) && (xj < xk) && (xk < xi + 40.0f);
+    }
+    CHECK(valid);
+}
@@ -0,0 +1,143 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../Track/simd_dca.h"
+
+#include <algorithm>
+#include <cmath>
+
+using KFP::SIMD::simd_float;
+using KFP::SIMD::SimdDca;
+using KFP::SIMD::SimdTrackParam;
+
+constexpr int NLanes = simd_float::SimdLen;
+
+SimdTrackParam makeTrack(float x, float y, float z, float px, float py, float pz)
+{
+    SimdTrackParam t;
+    const simd_float lane = simd_float::iota(0.0f);
+    t(0, 0) = simd_float{ x } + lane * 0.3f;
+    t(1, 0) = simd_float{ y } - lane * 0.1f;
+    t(2, 0) = simd_float{ z };
+    t(3, 0) = simd_float{ px };
+    t(4, 0) = simd_float{ py } + lane * 0.05f;
+    t(5, 0) = simd_float{ pz };
+    return t;
+}
+
+// Largest relative deviation of the analytic derivatives from central differences
+template <typename Dca> float derivativeError(const SimdTrackParam& t1, const SimdTrackParam& t2, const Dca& getDca)
+{
+    const SimdDca dca = getDca(t1, t2);
+    float error = 0.0f;
+    for (int track = 0; track < 2; ++track) {
+        for (int iPar = 0; iPar < 6; ++iPar) {
+            SimdTrackParam up[2]{ t1, t2 };
+            SimdTrackParam down[2]{ t1, t2 };
+            const float h = 3e-3f;
+            up[track](iPar, 0) += h;
+            down[track](iPar, 0) -= h;
+            const SimdDca dcaUp = getDca(up[0], up[1]);
+            const SimdDca dcaDown = getDca(down[0], down[1]);
+            for (int i = 0; i < 2; ++i) {
+                const simd_float numeric = (dcaUp.dS[i] - dcaDown.dS[i]) / (2.0f * h);
+                const simd_float diff = abs(numeric - dca.dsdr[2 * i + track][iPar]) /
+                                        (simd_float{ 0.1f } + abs(numeric));
+                for (int iLane = 0; iLane < NLanes; ++iLane) {
+                    error = std::max(error, diff[iLane]);
+                }
+            }
+        }
+    }
+    return error;
+}
+
+TEST_CASE("Testing straight line DCA") {
+    SUBCASE("Testing crossing lines") {
+        // Both pass through (1, 2, 3): at dS = 2 and dS = -1
+        SimdTrackParam t1 = makeTrack(0, 0, 0, 0.5f, 1.0f, 1.5f);
+        t1(0, 0) = simd_float{ 0.0f };
+        t1(1, 0) = simd_float{ 0.0f };
+        t1(4, 0) = simd_float{ 1.0f };
+        SimdTrackParam t2 = makeTrack(2, 1, 2, 1.0f, -1.0f, -1.0f);
+        t2(0, 0) = simd_float{ 2.0f };
+        t2(1, 0) = simd_float{ 1.0f };
+        t2(4, 0) = simd_float{ -1.0f };
+        const SimdDca dca = KFP::SIMD::dcaLine(t1, t2);
+        CHECK_FALSE(dca.parallel.OR());
+        CHECK(dca.dS[0][0] == doctest::Approx(2.0f));
+        CHECK(dca.dS[1][0] == doctest::Approx(-1.0f));
+        CHECK(dca.distance[0] == doctest::Approx(0.0f).epsilon(1e-5));
+        CHECK(dca.point[0][0] == doctest::Approx(1.0f));
+        CHECK(dca.point[1][0] == doctest::Approx(2.0f));
+        CHECK(dca.point[2][0] == doctest::Approx(3.0f));
+    }
+    SUBCASE("Testing skew lines") {
+        // x axis and a line along y at z = 2
+        const SimdTrackParam t1 = makeTrack(0, 0, 0, 1, 0, 0);
+        const SimdTrackParam t2 = makeTrack(3, 0, 2, 0, 1, 0);
+        const SimdDca dca = KFP::SIMD::dcaLine(t1, t2);
+        CHECK(dca.distance[0] == doctest::Approx(2.0f));
+        CHECK(dca.point[2][0] == doctest::Approx(1.0f));
+    }
+    SUBCASE("Testing parallel lines") {
+        const SimdTrackParam t1 = makeTrack(0, 0, 0, 1, 1, 1);
+        SimdTrackParam t2 = makeTrack(0, 1, 0, 1, 1, 1);
+        t2(3, 0) = t1(3, 0);
+        t2(4, 0) = t1(4, 0);
+        t2(5, 0) = t1(5, 0);
+        const SimdDca dca = KFP::SIMD::dcaLine(t1, t2);
+        CHECK(dca.parallel.AND());
+        CHECK((dca.dS[0] == simd_float{ 0.0f }).AND());
+        bool finite = true;
+        for (int iLane = 0; iLane < NLanes; ++iLane) {
+            finite = finite && std::isfinite(dca.distance[iLane]) && std::isfinite(dca.dS[1][iLane]);
+        }
+        CHECK(finite);
+    }
+    SUBCASE("Testing derivatives") {
+        const SimdTrackParam t1 = makeTrack(0.5f, -1, 2, 0.8f, 0.3f, 1.1f);
+        const SimdTrackParam t2 = makeTrack(1, 2, 1, -0.4f, 0.9f, 0.7f);
+        CHECK(derivativeError(t1, t2, [](const SimdTrackParam& a, const SimdTrackParam& b) {
+                  return KFP::SIMD::dcaLine(a, b);
+              }) < 1e-2f);
+    }
+}
+
+TEST_CASE("Testing helix DCA") {
+    const simd_float Bz{ 5.0f };
+    const simd_float qPos{ 1.0f };
+    const simd_float qNeg{ -1.0f };
+    // A V0-like pair: both tracks start near a common vertex
+    const SimdTrackParam t1 = makeTrack(2.0f, 1.0f, 10.0f, 0.3f, 0.2f, 1.0f);
+    const SimdTrackParam t2 = makeTrack(2.5f, 0.5f, 11.0f, -0.1f, 0.35f, 0.8f);
+    const SimdDca dca = KFP::SIMD::dcaHelix(t1, qPos, t2, qNeg, Bz, 3);
+    CHECK_FALSE(dca.parallel.OR());
+
+    // Stationarity: the connecting line is orthogonal to both helix tangents
+    SimdTrackParam x1 = t1;
+    SimdTrackParam x2 = t2;
+    KFP::SIMD::transportBz(x1, qPos, Bz, dca.dS[0]);
+    KFP::SIMD::transportBz(x2, qNeg, Bz, dca.dS[1]);
+    simd_float dist2{ 0.0f }, proj1{ 0.0f }, proj2{ 0.0f };
+    for (int i = 0; i < 3; ++i) {
+        const simd_float diff = x1(i, 0) - x2(i, 0);
+        dist2 += diff * diff;
+        proj1 += diff * x1(i + 3, 0);
+        proj2 += diff * x2(i + 3, 0);
+    }
+    CHECK((abs(proj1) < simd_float{ 1e-4f }).AND());
+    CHECK((abs(proj2) < simd_float{ 1e-4f }).AND());
+    CHECK((abs(sqrt(dist2) - dca.distance) < simd_float{ 1e-4f }).AND());
+    CHECK((abs(dca.point[2] - simd_float{ 0.5f } * (x1(2, 0) + x2(2, 0))) < simd_float{ 1e-4f }).AND());
+
+    // Without field the helix and the line solutions agree
+    const SimdDca line = KFP::SIMD::dcaLine(t1, t2);
+    const SimdDca flat = KFP::SIMD::dcaHelix(t1, qPos, t2, qNeg, simd_float{ 0.0f });
+    CHECK((abs(line.dS[0] - flat.dS[0]) < simd_float{ 1e-5f }).AND());
+
+    CHECK(derivativeError(t1, t2, [&](const SimdTrackParam& a, const SimdTrackParam& b) {
+              return KFP::SIMD::dcaHelix(a, qPos, b, qNeg, Bz, 3);
+          }) < 1e-2f);
+}
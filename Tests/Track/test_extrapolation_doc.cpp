@@ -0,0 +1,120 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../Track/simd_extrapolation.h"
+
+#include <cmath>
+
+using KFP::SIMD::simd_float;
+using KFP::SIMD::SimdTrackCov;
+using KFP::SIMD::SimdTrackParam;
+
+constexpr int NLanes = simd_float::SimdLen;
+
+struct Setup
+{
+    SimdTrackParam x{};
+    SimdTrackCov C{};
+    simd_float q{ 0.0f };
+    simd_float dS{ 0.0f };
+
+    Setup()
+    {
+        const simd_float lane = simd_float::iota(0.0f);
+        x(0, 0) = lane * 0.1f;
+        x(1, 0) = simd_float{ -0.2f };
+        x(2, 0) = simd_float{ 1.0f };
+        x(3, 0) = simd_float{ 0.4f } + lane * 0.05f;
+        x(4, 0) = simd_float{ -0.3f };
+        x(5, 0) = simd_float{ 1.2f };
+        q = select(lane < simd_float{ 1.0f }, simd_float{ -1.0f }, simd_float{ 1.0f });
+        // Different path in each lane (10 to 40 cm for p ~ 1.3 GeV/c)
+        dS = simd_float{ 8.0f } + lane * 7.0f;
+        for (int i = 0; i < 6; ++i) {
+            for (int j = 0; j <= i; ++j) {
+                C(i, j) = simd_float{ (i == j) ? 0.01f * float(i + 1) : 0.001f };
+            }
+        }
+    }
+};
+
+bool close(const simd_float& a, const simd_float& b, float tolerance)
+{
+    return (abs(a - b) <= simd_float{ tolerance } * (simd_float{ 1.0f } + abs(b))).AND();
+}
+
+struct UniformField
+{
+    float Bz;
+    void operator()(const simd_float (&)[3], simd_float (&B)[3]) const
+    {
+        B[0] = simd_float{ 0.0f };
+        B[1] = simd_float{ 0.0f };
+        B[2] = simd_float{ Bz };
+    }
+};
+
+TEST_CASE("Testing helix transport") {
+    Setup setup;
+    SimdTrackParam x = setup.x;
+    SUBCASE("Testing straight line without field") {
+        KFP::SIMD::transportBz(x, setup.q, simd_float{ 0.0f }, setup.dS);
+        for (int i = 0; i < 3; ++i) {
+            CHECK(close(x(i, 0), setup.x(i, 0) + setup.x(i + 3, 0) * setup.dS, 1e-6f));
+            CHECK(close(x(i + 3, 0), setup.x(i + 3, 0), 1e-6f));
+        }
+    }
+    SUBCASE("Testing helix geometry") {
+        const simd_float Bz{ 5.0f };
+        KFP::SIMD::transportBz(x, setup.q, Bz, setup.dS);
+        const simd_float pt0 = setup.x(3, 0) * setup.x(3, 0) + setup.x(4, 0) * setup.x(4, 0);
+        const simd_float pt1 = x(3, 0) * x(3, 0) + x(4, 0) * x(4, 0);
+        CHECK(close(pt1, pt0, 1e-5f));
+        CHECK(close(x(2, 0), setup.x(2, 0) + setup.x(5, 0) * setup.dS, 1e-6f));
+        // Reference for lane 0 in double precision
+        const double b = 5.0 * double(setup.q[0]) * 0.000299792458;
+        const double bs = b * setup.dS[0];
+        const double px = setup.x(3, 0)[0];
+        const double py = setup.x(4, 0)[0];
+        CHECK(x(0, 0)[0] == doctest::Approx(setup.x(0, 0)[0] + (px * std::sin(bs) + py * (1 - std::cos(bs))) / b).epsilon(1e-5));
+        CHECK(x(4, 0)[0] == doctest::Approx(py * std::cos(bs) - px * std::sin(bs)).epsilon(1e-5));
+    }
+    SUBCASE("Testing way back") {
+        SimdTrackCov C = setup.C;
+        const simd_float Bz{ 5.0f };
+        KFP::SIMD::transportBz(x, C, setup.q, Bz, setup.dS);
+        KFP::SIMD::transportBz(x, C, setup.q, Bz, -setup.dS);
+        for (int i = 0; i < 6; ++i) {
+            CHECK(close(x(i, 0), setup.x(i, 0), 1e-5f));
+        }
+        bool sameCov = true;
+        for (int k = 0; k < SimdTrackCov::Size; ++k) {
+            sameCov = sameCov && close(C[k], setup.C[k], 1e-4f);
+        }
+        CHECK(sameCov);
+    }
+}
+
+TEST_CASE("Testing Runge-Kutta transport") {
+    Setup setup;
+    const UniformField field{ 5.0f };
+    SimdTrackParam xHelix = setup.x;
+    SimdTrackCov CHelix = setup.C;
+    KFP::SIMD::transportBz(xHelix, CHelix, setup.q, simd_float{ field.Bz }, setup.dS);
+    SimdTrackParam xRk = setup.x;
+    SimdTrackCov CRk = setup.C;
+    KFP::SIMD::transportRungeKutta(xRk, CRk, setup.q, field, setup.dS, 4);
+    for (int i = 0; i < 6; ++i) {
+        CHECK(close(xRk(i, 0), xHelix(i, 0), 1e-5f));
+    }
+    bool sameCov = true;
+    for (int k = 0; k < SimdTrackCov::Size; ++k) {
+        sameCov = sameCov && close(CRk[k], CHelix[k], 1e-4f);
+    }
+    CHECK(sameCov);
+
+    SimdTrackParam xNoCov = setup.x;
+    KFP::SIMD::transportRungeKutta(xNoCov, setup.q, field, setup.dS, 4);
+    CHECK(close(xNoCov(1, 0), xRk(1, 0), 1e-7f));
+}
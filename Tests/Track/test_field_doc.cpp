@@ -0,0 +1,112 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../Track/simd_extrapolation.h"
+#include "../../Track/simd_field.h"
+
+#include <cmath>
+
+using KFP::SIMD::simd_float;
+using KFP::SIMD::SimdFieldRegion;
+using KFP::SIMD::SimdFieldSlice;
+
+constexpr int NLanes = simd_float::SimdLen;
+
+bool close(const simd_float& a, const simd_float& b, float tolerance)
+{
+    return (abs(a - b) <= simd_float{ tolerance } * (simd_float{ 1.0f } + abs(b))).AND();
+}
+
+TEST_CASE("Testing polynomial schemes") {
+    const float c[9]{ 1.0f, -0.5f, 0.25f, 0.125f, -0.0625f, 0.03f, 0.02f, -0.01f, 0.005f };
+    const auto coef = [&](auto k) { return simd_float{ c[k] }; };
+    const simd_float x = simd_float::iota(-1.0f) * 0.7f;
+    simd_float reference{ 0.0f };
+    for (int k = 8; k >= 0; --k) {
+        reference = reference * x + c[k];
+    }
+    CHECK(close(KFP::SIMD::Detail::horner<9>(x, coef), reference, 1e-6f));
+    CHECK(close(KFP::SIMD::Detail::estrin<9>(x, coef), reference, 1e-6f));
+    CHECK(close(KFP::SIMD::Detail::estrin<5>(x, coef), KFP::SIMD::Detail::horner<5>(x, coef), 1e-6f));
+    CHECK(close(KFP::SIMD::Detail::power<7>(x), x * x * x * x * x * x * x, 1e-6f));
+}
+
+TEST_CASE("Testing field slice") {
+    constexpr int Degree = 5;
+    using Slice = SimdFieldSlice<Degree>;
+    CHECK(Slice::NCoefficients == 21);
+    CHECK(Slice::index(0, 0) == 0);
+    CHECK(Slice::index(1, 0) == 1);
+    CHECK(Slice::index(0, 1) == 2);
+    CHECK(Slice::index(1, 1) == 4);
+    CHECK(Slice::index(0, 5) == 20);
+
+    float cx[21], cy[21], cz[21];
+    for (int k = 0; k < 21; ++k) {
+        cx[k] = 0.1f * float(k % 5) - 0.2f;
+        cy[k] = 0.05f * float(k % 3);
+        cz[k] = (k == 0) ? 10.0f : 0.01f * float(k);
+    }
+    const Slice slice{ cx, cy, cz };
+    const simd_float x = simd_float::iota(-2.0f) * 0.9f;
+    const simd_float y = simd_float{ 1.3f } - simd_float::iota(0.0f) * 0.4f;
+    simd_float B[3];
+    slice.get(x, y, B);
+    const float* coefficients[3]{ cx, cy, cz };
+    bool matches = true;
+    for (int iLane = 0; iLane < NLanes; ++iLane) {
+        for (int component = 0; component < 3; ++component) {
+            double reference = 0.0;
+            for (int i = 0; i <= Degree; ++i) {
+                for (int j = 0; i + j <= Degree; ++j) {
+                    reference += coefficients[component][Slice::index(i, j)] *
+                                 std::pow(double(x[iLane]), i) * std::pow(double(y[iLane]), j);
+                }
+            }
+            matches = matches && std::abs(B[component][iLane] - reference) < 1e-5 * (1.0 + std::abs(reference));
+        }
+    }
+    CHECK(matches);
+}
+
+TEST_CASE("Testing field region") {
+    // Exact parabola in every component, different in each lane
+    const simd_float lane = simd_float::iota(0.0f);
+    const auto field = [&](const simd_float& z, simd_float (&B)[3]) {
+        B[0] = simd_float{ 0.1f } + z * 0.01f;
+        B[1] = lane * 0.2f - z * z * 0.001f;
+        B[2] = simd_float{ 5.0f } + (z - 10.0f) * (z - 10.0f) * 0.003f;
+    };
+    const simd_float z0 = lane + 10.0f;
+    const simd_float z1 = lane + 30.0f;
+    const simd_float z2{ 55.0f };
+    simd_float B0[3], B1[3], B2[3];
+    field(z0, B0);
+    field(z1, B1);
+    field(z2, B2);
+    SimdFieldRegion region;
+    region.set(B0, z0, B1, z1, B2, z2);
+
+    const simd_float z = simd_float{ 42.0f } - lane * 3.0f;
+    simd_float B[3], reference[3];
+    region.get(z, B);
+    field(z, reference);
+    for (int component = 0; component < 3; ++component) {
+        CHECK(close(B[component], reference[component], 1e-4f));
+    }
+    SUBCASE("Testing linear region") {
+        SimdFieldRegion line;
+        line.set(B0, z0, B1, z1);
+        line.get(z1, B);
+        CHECK(close(B[1], B1[1], 1e-5f));
+        CHECK((line.coefficient(2, 2) == simd_float{ 0.0f }).AND());
+    }
+    SUBCASE("Testing as transport field") {
+        KFP::SIMD::SimdTrackParam x;
+        x(5, 0) = simd_float{ 1.0f };
+        x(3, 0) = simd_float{ 0.2f };
+        KFP::SIMD::transportRungeKutta(x, simd_float{ 1.0f }, region, simd_float{ 20.0f }, 4);
+        CHECK(close(x(2, 0), simd_float{ 20.0f }, 1e-3f));
+    }
+}
@@ -0,0 +1,91 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../Track/simd_field_map.h"
+
+#include <cmath>
+#include <limits>
+
+using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_mask;
+using KFP::SIMD::SimdFieldMap;
+
+constexpr int NLanes = simd_float::SimdLen;
+
+// Trilinear functions are reproduced exactly by the interpolation
+float linearField(int c, float x, float y, float z)
+{
+    return 0.5f * float(c + 1) + 0.01f * x - 0.02f * y + 0.03f * z + 0.001f * x * y * float(c);
+}
+
+SimdFieldMap makeMap()
+{
+    SimdFieldMap map{ 11, 6, 21, { -50.0f, -25.0f, 0.0f }, { 10.0f, 10.0f, 5.0f } };
+    for (int ix = 0; ix < map.size(0); ++ix) {
+        for (int iy = 0; iy < map.size(1); ++iy) {
+            for (int iz = 0; iz < map.size(2); ++iz) {
+                const float x = map.node(0, ix);
+                const float y = map.node(1, iy);
+                const float z = map.node(2, iz);
+                map.set(ix, iy, iz, linearField(0, x, y, z), linearField(1, x, y, z), linearField(2, x, y, z));
+            }
+        }
+    }
+    return map;
+}
+
+TEST_CASE("Testing field map interpolation") {
+    const SimdFieldMap map = makeMap();
+    CHECK(map.index(1, 2, 3) == (1 * 6 + 2) * 21 + 3);
+
+    SUBCASE("Testing inside points") {
+        const simd_float lane = simd_float::iota(0.0f);
+        const simd_float x = lane * 11.3f - 43.0f;
+        const simd_float y = simd_float{ 24.9f } - lane * 6.1f;
+        const simd_float z = lane * 12.7f + 0.3f;
+        simd_float B[3];
+        const simd_mask inside = map.get(x, y, z, B);
+        CHECK(inside.AND());
+        bool matches = true;
+        for (int iLane = 0; iLane < NLanes; ++iLane) {
+            for (int c = 0; c < 3; ++c) {
+                const float reference = linearField(c, x[iLane], y[iLane], z[iLane]);
+                matches = matches && std::abs(B[c][iLane] - reference) < 1e-4f * (1.0f + std::abs(reference));
+            }
+        }
+        CHECK(matches);
+    }
+    SUBCASE("Testing grid edges") {
+        simd_float B[3];
+        const simd_mask inside = map.get(simd_float{ 50.0f }, simd_float{ 25.0f }, simd_float{ 100.0f }, B);
+        CHECK(inside.AND());
+        CHECK(B[2][0] == doctest::Approx(linearField(2, 50.0f, 25.0f, 100.0f)));
+    }
+    SUBCASE("Testing outside points") {
+        float x[NLanes];
+        for (int iLane = 0; iLane < NLanes; ++iLane) {
+            x[iLane] = 0.0f;
+        }
+        x[0] = 50.5f;
+        x[NLanes - 1] = std::numeric_limits<float>::quiet_NaN();
+        simd_float B[3];
+        const simd_mask inside = map.get(simd_float{}.load(x), simd_float{ 0.0f }, simd_float{ 10.0f }, B);
+        CHECK_FALSE(inside[0]);
+        CHECK_FALSE(inside[NLanes - 1]);
+        CHECK(B[0][0] == 0.0f);
+        CHECK(B[1][NLanes - 1] == 0.0f);
+        if (NLanes > 2) {
+            CHECK(inside[1]);
+            CHECK(B[1][1] == doctest::Approx(linearField(1, 0.0f, 0.0f, 10.0f)));
+        }
+        const simd_mask below = map.get(simd_float{ 0.0f }, simd_float{ -25.5f }, simd_float{ 10.0f }, B);
+        CHECK_FALSE(below.OR());
+    }
+    SUBCASE("Testing field callback") {
+        const simd_float xyz[3]{ simd_float{ 1.0f }, simd_float{ 2.0f }, simd_float{ 3.0f } };
+        simd_float B[3];
+        map(xyz, B);
+        CHECK(B[0][0] == doctest::Approx(linearField(0, 1.0f, 2.0f, 3.0f)));
+    }
+}
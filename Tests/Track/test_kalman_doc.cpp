@@ -0,0 +1,173 @@
+// -*- C++ -*-
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+#include "../../Track/simd_kalman.h"
+
+#include <cmath>
+
+using KFP::SIMD::simd_float;
+using KFP::SIMD::simd_int;
+using KFP::SIMD::simd_mask;
+using KFP::SIMD::SimdMatrix;
+using KFP::SIMD::SimdProjection;
+using KFP::SIMD::SimdSymMatrix;
+using KFP::SIMD::SimdTrackState;
+
+constexpr int NLanes = simd_float::SimdLen;
+
+// Reference update of a single lane in double precision, M = 2
+template <std::size_t N>
+void kalmanReference(double (&x)[N], double (&C)[N][N], double& chi2, const double (&H)[2][N],
+                     const double (&m)[2], const double (&V)[2][2])
+{
+    double CHt[N][2]{};
+    double S[2][2]{};
+    double r[2]{};
+    for (int k = 0; k < 2; ++k) {
+        r[k] = m[k];
+        for (std::size_t i = 0; i < N; ++i) {
+            r[k] -= H[k][i] * x[i];
+            for (std::size_t j = 0; j < N; ++j) {
+                CHt[i][k] += C[i][j] * H[k][j];
+            }
+        }
+    }
+    for (int k = 0; k < 2; ++k) {
+        for (int l = 0; l < 2; ++l) {
+            S[k][l] = V[k][l];
+            for (std::size_t i = 0; i < N; ++i) {
+                S[k][l] += H[k][i] * CHt[i][l];
+            }
+        }
+    }
+    const double det = S[0][0] * S[1][1] - S[0][1] * S[1][0];
+    const double Sinv[2][2]{ { S[1][1] / det, -S[0][1] / det }, { -S[1][0] / det, S[0][0] / det } };
+    double K[N][2]{};
+    for (std::size_t i = 0; i < N; ++i) {
+        for (int k = 0; k < 2; ++k) {
+            K[i][k] = CHt[i][0] * Sinv[0][k] + CHt[i][1] * Sinv[1][k];
+        }
+        x[i] += K[i][0] * r[0] + K[i][1] * r[1];
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < N; ++j) {
+            C[i][j] -= K[i][0] * CHt[j][0] + K[i][1] * CHt[j][1];
+        }
+    }
+    for (int k = 0; k < 2; ++k) {
+        for (int l = 0; l < 2; ++l) {
+            chi2 += r[k] * Sinv[k][l] * r[l];
+        }
+    }
+}
+
+struct Setup
+{
+    SimdTrackState<5> track{};
+    double x[NLanes][5]{};
+    double C[NLanes][5][5]{};
+    SimdMatrix<2, 1> m{};
+    double mLane[NLanes][2]{};
+    SimdSymMatrix<2> V{};
+
+    Setup()
+    {
+        for (int iLane = 0; iLane < NLanes; ++iLane) {
+            for (int i = 0; i < 5; ++i) {
+                x[iLane][i] = 0.1 * (i + 1) + 0.01 * iLane;
+                for (int j = 0; j < 5; ++j) {
+                    C[iLane][i][j] = (i == j ? 1.0 + 0.1 * i : 0.0) + ((i + j) % 3 == 0 && i != j ? 0.05 : 0.0);
+                }
+            }
+            mLane[iLane][0] = 0.3 - 0.02 * iLane;
+            mLane[iLane][1] = -0.1 + 0.03 * iLane;
+        }
+        for (int i = 0; i < 5; ++i) {
+            float xi[NLanes];
+            for (int iLane = 0; iLane < NLanes; ++iLane) {
+                xi[iLane] = float(x[iLane][i]);
+            }
+            track.x(i, 0).load(xi);
+            for (int j = 0; j <= i; ++j) {
+                track.C(i, j) = simd_float{ float(C[0][i][j]) };
+            }
+        }
+        for (int k = 0; k < 2; ++k) {
+            float mk[NLanes];
+            for (int iLane = 0; iLane < NLanes; ++iLane) {
+                mk[iLane] = float(mLane[iLane][k]);
+            }
+            m(k, 0).load(mk);
+        }
+        V(0, 0) = simd_float{ 0.01f };
+        V(1, 1) = simd_float{ 0.04f };
+        V(1, 0) = simd_float{ 0.005f };
+    }
+
+    bool matches(const double (&H)[2][5], const simd_mask& updated) const
+    {
+        const double VLane[2][2]{ { 0.01, 0.005 }, { 0.005, 0.04 } };
+        bool close = true;
+        for (int iLane = 0; iLane < NLanes; ++iLane) {
+            double xRef[5];
+            double CRef[5][5];
+            double chi2Ref = 0.0;
+            for (int i = 0; i < 5; ++i) {
+                xRef[i] = x[iLane][i];
+                for (int j = 0; j < 5; ++j) {
+                    CRef[i][j] = C[iLane][i][j];
+                }
+            }
+            if (updated[iLane]) {
+                kalmanReference(xRef, CRef, chi2Ref, H, mLane[iLane], VLane);
+            }
+            for (int i = 0; i < 5; ++i) {
+                close = close && std::abs(track.x(i, 0)[iLane] - xRef[i]) < 1e-5;
+                for (int j = 0; j <= i; ++j) {
+                    close = close && std::abs(track.C(i, j)[iLane] - CRef[i][j]) < 1e-5;
+                }
+            }
+            close = close && std::abs(track.chi2[iLane] - chi2Ref) < 1e-4 * (1.0 + chi2Ref);
+            close = close && track.ndf[iLane] == (updated[iLane] ? 2 : 0);
+        }
+        return close;
+    }
+};
+
+TEST_CASE("Testing Kalman measurement update") {
+    Setup setup;
+    SUBCASE("Testing projection") {
+        const double H[2][5]{ { 1, 0, 0, 0, 0 }, { 0, 1, 0, 0, 0 } };
+        const simd_mask updated = kalmanUpdate(setup.track, SimdProjection<0, 1>{}, setup.m, setup.V);
+        CHECK(updated.AND());
+        CHECK(setup.matches(H, updated));
+    }
+    SUBCASE("Testing dense projection matrix") {
+        const double H[2][5]{ { 1, 0, 0.5, 0, 0 }, { 0, 1, 0, -0.3, 0 } };
+        SimdMatrix<2, 5> Hs;
+        for (int k = 0; k < 2; ++k) {
+            for (int i = 0; i < 5; ++i) {
+                Hs(k, i) = simd_float{ float(H[k][i]) };
+            }
+        }
+        const simd_mask updated = kalmanUpdate(setup.track, Hs, setup.m, setup.V);
+        CHECK(updated.AND());
+        CHECK(setup.matches(H, updated));
+    }
+    SUBCASE("Testing lanes without measurement") {
+        const double H[2][5]{ { 0, 0, 1, 0, 0 }, { 0, 0, 0, 0, 1 } };
+        const simd_mask active = simd_float::iota(0.0f) < simd_float{ 1.0f };
+        const simd_mask updated =
+            kalmanUpdate(setup.track, SimdProjection<2, 4>{}, setup.m, setup.V, active);
+        CHECK((updated == active));
+        CHECK(setup.matches(H, updated));
+    }
+    SUBCASE("Testing invalid measurement covariance") {
+        const double H[2][5]{ { 1, 0, 0, 0, 0 }, { 0, 1, 0, 0, 0 } };
+        setup.V(0, 0) = simd_float{ -10.0f };
+        const simd_mask updated = kalmanUpdate(setup.track, SimdProjection<0, 1>{}, setup.m, setup.V);
+        CHECK_FALSE(updated.OR());
+        CHECK(setup.matches(H, updated));
+    }
+}
@@ -0,0 +1,277 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_COMBINATORICS_H
+#define SIMD_COMBINATORICS_H
+
+#include "../simd.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <utility>
+
+// Candidate search over all combinations of particle lists (V0s from positive
+// and negative tracks, cascades from V0s and tracks). The inner list is
+// scanned SimdLen entries at a time against one outer entry, a chain of cuts
+// returns simd_mask and the surviving combinations are compress-stored.
+//
+// A cut is called as cut(iOuter, iInner) and judges the SimdLen inner entries
+// [iInner, iInner + SimdLen): it broadcasts what it needs of entry iOuter and
+// loads the inner block from SoA columns with load_a. iInner is always a
+// multiple of SimdLen, so inner columns must be aligned and readable up to
+// paddedSize(nInner); the lanes past the end are discarded.
+
+namespace KFP {
+namespace SIMD {
+
+// Number of entries to allocate for an inner SoA column of n entries
+constexpr int paddedSize(int n)
+{
+    return (n + simd_int::SimdLen - 1) / simd_int::SimdLen * simd_int::SimdLen;
+}
+
+// ------------------------------------------------------
+// Cut chain
+// ------------------------------------------------------
+// Cuts evaluated in the given order, each one only while some lane of the
+// block survives: put the cheap and selective cuts first.
+template <typename... Cuts> class SimdCutChain
+{
+public:
+    static constexpr std::size_t NCuts{ sizeof...(Cuts) };
+
+    explicit SimdCutChain(const Cuts&... cuts) : cuts_{ cuts... } {}
+
+    simd_mask operator()(int iOuter, int iInner, const simd_mask& active) const
+    {
+        return evaluate<0>(iOuter, iInner, active);
+    }
+
+private:
+    template <std::size_t I>
+    simd_mask evaluate(int iOuter, int iInner, const simd_mask& active) const
+    {
+        if constexpr (I == NCuts) {
+            return active;
+        } else {
+            const simd_mask pass = active && simd_mask{ std::get<I>(cuts_)(iOuter, iInner) };
+            if (!pass.OR()) {
+                return pass;
+            }
+            return evaluate<I + 1>(iOuter, iInner, pass);
+        }
+    }
+
+    std::tuple<Cuts...> cuts_;
+};
+
+template <typename... Cuts> SimdCutChain<Cuts...> makeCutChain(const Cuts&... cuts)
+{
+    return SimdCutChain<Cuts...>{ cuts... };
+}
+
+// ------------------------------------------------------
+// Combination list
+// ------------------------------------------------------
+// Combinations of N entries in SoA: entry k of combination c is index(k)[c].
+// The columns keep SimdLen elements of slack past size() for compress-store.
+template <int N> class SimdCombinations
+{
+public:
+    static_assert(N > 0, "[Error] (KFP::SIMD::SimdCombinations): Invalid number of entries.");
+    typedef Vector<int, simd_int::SimdSize> column_type;
+
+    SimdCombinations()
+    {
+        reserve(0);
+    }
+
+    int size() const
+    {
+        return size_;
+    }
+    void clear()
+    {
+        size_ = 0;
+    }
+    // Room for n combinations and the compress-store slack
+    void reserve(int n)
+    {
+        const std::size_t capacity = std::size_t(n) + simd_int::SimdLen;
+        if (index_[0].size() < capacity) {
+            for (column_type& column : index_) {
+                column.resize(capacity);
+            }
+        }
+    }
+    void push_back(const int (&entries)[static_cast<std::size_t>(N)])
+    {
+        reserve(size_ + 1);
+        for (int k = 0; k < N; ++k) {
+            index_[k][static_cast<std::size_t>(size_)] = entries[k];
+        }
+        ++size_;
+    }
+
+    const int* index(int k) const
+    {
+        return index_[k].data();
+    }
+    int operator()(int k, int c) const
+    {
+        return index_[k][static_cast<std::size_t>(c)];
+    }
+
+    // Appends the lanes of inner selected by mask, with entries [0, N - 1)
+    // taken from combination iOuter of outer
+    void append(const SimdCombinations<N - 1>& outer, int iOuter, const simd_int& inner,
+                const simd_mask& mask)
+    {
+        reserve(size_ + simd_int::SimdLen);
+        for (int k = 0; k < N - 1; ++k) {
+            simd_int{ outer(k, iOuter) }.store(index_[k].data() + size_);
+        }
+        size_ += compressStore(inner, mask, index_[N - 1].data() + size_);
+    }
+    // Same with a single outer index
+    void append(int iOuter, const simd_int& inner, const simd_mask& mask)
+    {
+        static_assert(N == 2, "[Error] (KFP::SIMD::SimdCombinations): Single outer index needs pairs.");
+        reserve(size_ + simd_int::SimdLen);
+        simd_int{ iOuter }.store(index_[0].data() + size_);
+        size_ += compressStore(inner, mask, index_[1].data() + size_);
+    }
+
+    // Stores the lanes of val selected by mask contiguously to out, which needs
+    // room for SimdLen values, and returns their number. Branchless: every lane
+    // is written and the position only advances on selected lanes.
+    static int compressStore(const simd_int& val, const simd_mask& mask, int* out)
+    {
+        constexpr int SimdLen = simd_int::SimdLen;
+        if (mask.AND()) {
+            val.store(out);
+            return SimdLen;
+        }
+        __KFP_SIMD__SPEC_ALIGN(simd_int::SimdSize) int data[SimdLen]{}; // Helper data array
+        __KFP_SIMD__SPEC_ALIGN(simd_int::SimdSize) int flag[SimdLen]{}; // Helper data array
+        val.store_a(data);
+        simd_int{ mask.maski() }.store_a(flag);
+        int count = 0;
+        for (int iLane = 0; iLane < SimdLen; ++iLane) {
+            out[count] = data[iLane];
+            count -= flag[iLane]; // true lanes are -1
+        }
+        return count;
+    }
+
+private:
+    column_type index_[static_cast<std::size_t>(N)];
+    int size_{ 0 };
+};
+
+typedef SimdCombinations<2> SimdPairList;
+typedef SimdCombinations<3> SimdTripletList;
+
+// ------------------------------------------------------
+// Cache blocking
+// ------------------------------------------------------
+// Both lists are cut in tiles that stay in L1 while every outer entry of one
+// tile is paired with every inner entry of the other. The defaults fit a
+// 32 KB L1 with about 6 float columns per inner entry.
+struct SimdTiling
+{
+    int outer{ 64 };
+    int inner{ 1024 };
+};
+
+namespace Detail {
+
+// Calls emit(iOuter, iInner, mask) for every inner block of every outer entry
+// with the mask of the combinations passing cuts
+template <typename Chain, typename Emit>
+void combineTiled(int nOuter, int nInner, const Chain& cuts, const SimdTiling& tiling, const Emit& emit)
+{
+    constexpr int SimdLen = simd_int::SimdLen;
+    assert(((tiling.outer > 0) && (tiling.inner > 0) && (tiling.inner % SimdLen == 0)) &&
+           (std::string{ "[Error] (KFP::SIMD::combineTiled): Inner tile must be a positive multiple of SimdLen, given: " } +
+            std::to_string(tiling.inner))
+               .data());
+    const simd_mask full{ true };
+    for (int outerBegin = 0; outerBegin < nOuter; outerBegin += tiling.outer) {
+        const int outerEnd = std::min(outerBegin + tiling.outer, nOuter);
+        for (int innerBegin = 0; innerBegin < nInner; innerBegin += tiling.inner) {
+            const int innerEnd = std::min(innerBegin + tiling.inner, nInner);
+            const int innerMain = innerEnd - (innerEnd - innerBegin) % SimdLen;
+            for (int iOuter = outerBegin; iOuter < outerEnd; ++iOuter) {
+                int iInner = innerBegin;
+                for (; iInner < innerMain; iInner += SimdLen) {
+                    const simd_mask mask = cuts(iOuter, iInner, full);
+                    if (mask.OR()) {
+                        emit(iOuter, iInner, mask);
+                    }
+                }
+                // Masked epilogue: lanes past the end start inactive
+                if (iInner < innerEnd) {
+                    const simd_mask mask = cuts(iOuter, iInner, laneMask(innerEnd - iInner));
+                    if (mask.OR()) {
+                        emit(iOuter, iInner, mask);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace Detail
+
+// ------------------------------------------------------
+// Pairs and triplets
+// ------------------------------------------------------
+// Appends every pair (i, j), i < nFirst, j < nSecond, passing cuts to pairs
+// and returns the number found. The pairs come grouped by tile, ordered by j
+// within one i and tile.
+template <typename Chain>
+int findPairs(int nFirst, int nSecond, const Chain& cuts, SimdPairList& pairs,
+              const SimdTiling& tiling = SimdTiling{})
+{
+    const int size = pairs.size();
+    Detail::combineTiled(nFirst, nSecond, cuts, tiling,
+                         [&](int iFirst, int iSecond, const simd_mask& mask) {
+                             pairs.append(iFirst, simd_int::iota(iSecond), mask);
+                         });
+    return pairs.size() - size;
+}
+
+// Extends every combination of in with the entries k < nNext passing cuts;
+// the cuts get the index of the combination in in as outer index.
+template <int N, typename Chain>
+int extendCombinations(const SimdCombinations<N>& in, int nNext, const Chain& cuts,
+                       SimdCombinations<N + 1>& out, const SimdTiling& tiling = SimdTiling{})
+{
+    const int size = out.size();
+    Detail::combineTiled(in.size(), nNext, cuts, tiling,
+                         [&](int iCombination, int iNext, const simd_mask& mask) {
+                             out.append(in, iCombination, simd_int::iota(iNext), mask);
+                         });
+    return out.size() - size;
+}
+
+template <typename Chain>
+int findTriplets(const SimdPairList& pairs, int nThird, const Chain& cuts, SimdTripletList& triplets,
+                 const SimdTiling& tiling = SimdTiling{})
+{
+    return extendCombinations(pairs, nThird, cuts, triplets, tiling);
+}
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_COMBINATORICS_H
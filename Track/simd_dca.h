@@ -0,0 +1,202 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_DCA_H
+#define SIMD_DCA_H
+
+#include "simd_extrapolation.h"
+
+// Distance of closest approach between two batches of tracks, one pair per
+// lane, with the parameters of Track/simd_extrapolation.h. The steps dS to
+// the points of closest approach and their derivatives are what the
+// KFParticle vertex and mass constraint fits consume.
+
+namespace KFP {
+namespace SIMD {
+
+struct SimdDca
+{
+    // Steps of the two tracks to their points of closest approach
+    simd_float dS[2];
+    // Derivatives of dS[i] over the parameters of track j in dsdr[2 * i + j]
+    simd_float dsdr[4][6];
+    // Middle of the closest approach, the two-track vertex estimate
+    simd_float point[3];
+    // Distance of the two points
+    simd_float distance{ 0.0f };
+    // Lanes with (nearly) parallel directions: dS[0] is 0 and track 2 is
+    // projected onto the first point
+    simd_mask parallel{ false };
+};
+
+namespace Detail {
+
+// Straight lines r1 + p1 s1 and r2 + p2 s2: with d = r1 - r2
+//   s1 = (b f - c e) / det, s2 = (a f - b e) / det, det = a c - b^2
+// a = p1.p1, b = p1.p2, c = p2.p2, e = p1.d, f = p2.d
+__KFP_SIMD__INLINE void dcaLineImpl(const SimdTrackParam& t1, const SimdTrackParam& t2, SimdDca& dca)
+{
+    simd_float d[3];
+    staticFor<3>([&](auto i) { d[i] = t1(i, 0) - t2(i, 0); });
+    const auto dot = [](auto&& u, auto&& v) {
+        return fmadd(u(0), v(0), fmadd(u(1), v(1), u(2) * v(2)));
+    };
+    const auto p1 = [&](int i) { return t1(i + 3, 0); };
+    const auto p2 = [&](int i) { return t2(i + 3, 0); };
+    const auto dv = [&](int i) { return d[i]; };
+    const simd_float a = dot(p1, p1);
+    const simd_float b = dot(p1, p2);
+    const simd_float c = dot(p2, p2);
+    const simd_float e = dot(p1, dv);
+    const simd_float f = dot(p2, dv);
+    const simd_float det = fnmadd(b, b, a * c);
+    const simd_float zero{ 0.0f };
+    const simd_float one{ 1.0f };
+
+    // sin^2 of the opening angle below 1e-6
+    dca.parallel = det <= simd_float{ 1e-6f } * a * c;
+    const simd_float detInv = one / select(dca.parallel, c, det);
+    const simd_float s1 = select(dca.parallel, zero, fmsub(b, f, c * e) * detInv);
+    const simd_float s2 = select(dca.parallel, f * detInv, fmsub(a, f, b * e) * detInv);
+    dca.dS[0] = s1;
+    dca.dS[1] = s2;
+
+    // Derivatives of a, b, c, e, f over one parameter, then of the solution
+    const auto derive = [&](int track, int iPar, const simd_float& da, const simd_float& db,
+                            const simd_float& dc, const simd_float& de, const simd_float& df) {
+        const simd_float ddet = fmadd(da, c, fmsub(a, dc, simd_float{ 2.0f } * b * db));
+        const simd_float dN1 = fmadd(db, f, fmsub(b, df, fmadd(dc, e, c * de)));
+        const simd_float dN2 = fmadd(da, f, fmsub(a, df, fmadd(db, e, b * de)));
+        const simd_float ds1 = select(dca.parallel, zero, fnmadd(s1, ddet, dN1) * detInv);
+        const simd_float ds2 = select(dca.parallel, fnmadd(s2, dc, df) * detInv,
+                                      fnmadd(s2, ddet, dN2) * detInv);
+        dca.dsdr[track][iPar] = ds1;
+        dca.dsdr[2 + track][iPar] = ds2;
+    };
+    staticFor<3>([&](auto i) {
+        derive(0, i, zero, zero, zero, p1(i), p2(i));
+        derive(0, i + 3, simd_float{ 2.0f } * p1(i), p2(i), zero, d[i], zero);
+        derive(1, i, zero, zero, zero, -p1(i), -p2(i));
+        derive(1, i + 3, zero, p1(i), simd_float{ 2.0f } * p2(i), zero, d[i]);
+    });
+}
+
+// Fills the point and distance from the closest points r + p dS
+__KFP_SIMD__INLINE void dcaPoint(const SimdTrackParam& t1, const simd_float& s1,
+                                 const SimdTrackParam& t2, const simd_float& s2, SimdDca& dca)
+{
+    simd_float dist2{ 0.0f };
+    staticFor<3>([&](auto i) {
+        const simd_float r1 = fmadd(t1(i + 3, 0), s1, t1(i, 0));
+        const simd_float r2 = fmadd(t2(i + 3, 0), s2, t2(i, 0));
+        dca.point[i] = simd_float{ 0.5f } * (r1 + r2);
+        dist2 = fmadd(r1 - r2, r1 - r2, dist2);
+    });
+    dca.distance = sqrt(dist2);
+}
+
+} // namespace Detail
+
+// ------------------------------------------------------
+// Straight line approximation
+// ------------------------------------------------------
+inline SimdDca dcaLine(const SimdTrackParam& t1, const SimdTrackParam& t2)
+{
+    SimdDca dca;
+    Detail::dcaLineImpl(t1, t2, dca);
+    Detail::dcaPoint(t1, dca.dS[0], t2, dca.dS[1], dca);
+    return dca;
+}
+
+// ------------------------------------------------------
+// Helices in a constant field along z
+// ------------------------------------------------------
+// Newton iterations started from the straight line solution: both tracks are
+// moved along their helices to the current estimate and the straight line DCA
+// of the tangents gives the correction. The derivatives follow from the
+// conditions g = ((P1 - P2).p1, (P1 - P2).p2) = 0 at the helix points: the
+// straight line ones are corrected for the turning of p1 and p2 in dg/dS and
+// chained with the helix Jacobians.
+inline SimdDca dcaHelix(const SimdTrackParam& t1, const simd_float& q1, const SimdTrackParam& t2,
+                        const simd_float& q2, const simd_float& Bz, int nIterations = 2)
+{
+    SimdDca dca;
+    Detail::dcaLineImpl(t1, t2, dca);
+    simd_float s1 = dca.dS[0];
+    simd_float s2 = dca.dS[1];
+    const simd_mask parallel = dca.parallel;
+    SimdTrackParam x1, x2;
+    SimdMatrix<6, 6> F1, F2;
+    for (int iIteration = 0; iIteration <= nIterations; ++iIteration) {
+        x1 = t1;
+        x2 = t2;
+        Detail::transportBzImpl<true>(x1, &F1, q1, Bz, s1);
+        Detail::transportBzImpl<true>(x2, &F2, q2, Bz, s2);
+        Detail::dcaLineImpl(x1, x2, dca);
+        s1 += dca.dS[0];
+        s2 += dca.dS[1];
+    }
+    // Last correction, D = P1 - P2 at the points of closest approach
+    const simd_float ds1 = dca.dS[0];
+    const simd_float ds2 = dca.dS[1];
+    Detail::dcaPoint(x1, ds1, x2, ds2, dca);
+    dca.dS[0] = s1;
+    dca.dS[1] = s2;
+    dca.parallel = parallel || dca.parallel;
+
+    // dg/dS of the straight lines is L = ((a, -b), (b, -c)), on the helices
+    // G = L + diag(D.p1', D.p2') with p' = b (py, -px, 0). The derivatives
+    // of the lines are -L^-1 dg/dx, so the helix ones are G^-1 L times them.
+    const simd_float b1 = Bz * q1 * simd_float{ kCLight };
+    const simd_float b2 = Bz * q2 * simd_float{ kCLight };
+    simd_float D[3];
+    Detail::staticFor<3>([&](auto i) {
+        D[i] = fmadd(x1(i + 3, 0), ds1, x1(i, 0)) - fmadd(x2(i + 3, 0), ds2, x2(i, 0));
+    });
+    const simd_float a = fmadd(x1(3, 0), x1(3, 0), fmadd(x1(4, 0), x1(4, 0), x1(5, 0) * x1(5, 0)));
+    const simd_float b = fmadd(x1(3, 0), x2(3, 0), fmadd(x1(4, 0), x2(4, 0), x1(5, 0) * x2(5, 0)));
+    const simd_float c = fmadd(x2(3, 0), x2(3, 0), fmadd(x2(4, 0), x2(4, 0), x2(5, 0) * x2(5, 0)));
+    const simd_float turn1 = b1 * fmsub(D[0], x1(4, 0), D[1] * x1(3, 0));
+    const simd_float turn2 = b2 * fmsub(D[0], x2(4, 0), D[1] * x2(3, 0));
+    const simd_float G00 = a + turn1;
+    const simd_float G11 = turn2 - c;
+    const simd_float GdetInv = simd_float{ 1.0f } / fmadd(b, b, G00 * G11);
+    // M = G^-1 L, G = ((G00, -b), (b, G11))
+    const simd_float M00 = fmadd(G11, a, b * b) * GdetInv;
+    const simd_float M01 = -b * turn2 * GdetInv;
+    const simd_float M10 = b * turn1 * GdetInv;
+    const simd_float M11 = fnmadd(G00, c, b * b) * GdetInv;
+
+    // d(dS)/d(t) = M d(dS)/d(x) F
+    simd_float dsdr[4][6];
+    Detail::staticFor<2>([&](auto track) {
+        const SimdMatrix<6, 6>& F = (track == 0) ? F1 : F2;
+        Detail::staticFor<6>([&](auto l) {
+            const simd_float line0 = dca.dsdr[track][l];
+            const simd_float line1 = dca.dsdr[2 + track][l];
+            dca.dsdr[track][l] = fmadd(M00, line0, M01 * line1);
+            dca.dsdr[2 + track][l] = fmadd(M10, line0, M11 * line1);
+        });
+        Detail::staticFor<6>([&](auto j) {
+            Detail::staticFor<2>([&](auto i) {
+                simd_float sum = dca.dsdr[2 * i + track][0] * F(0, j);
+                Detail::staticFor<5>([&](auto l) {
+                    sum = fmadd(dca.dsdr[2 * i + track][l + 1], F(l + 1, j), sum);
+                });
+                dsdr[2 * i + track][j] = sum;
+            });
+        });
+    });
+    Detail::staticFor<4>([&](auto k) { Detail::staticFor<6>([&](auto j) { dca.dsdr[k][j] = dsdr[k][j]; }); });
+    return dca;
+}
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_DCA_H
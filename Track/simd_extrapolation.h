@@ -0,0 +1,199 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_EXTRAPOLATION_H
+#define SIMD_EXTRAPOLATION_H
+
+#include "../Math/simd_math.h"
+#include "../Math/simd_matrix.h"
+
+// Transport of SimdLen tracks with state (x, y, z, px, py, pz) in cm and
+// GeV/c, field in kG. As in KFParticle the step dS is the path length divided
+// by the momentum, so a straight line moves by p * dS. Every lane has its own
+// step, charge and field.
+
+namespace KFP {
+namespace SIMD {
+
+typedef SimdMatrix<6, 1> SimdTrackParam;
+typedef SimdSymMatrix<6> SimdTrackCov;
+
+// Speed of light in GeV/c per kG per cm
+constexpr float kCLight{ 0.000299792458f };
+
+namespace Detail {
+
+// Moves x along the helix, fills the Jacobian of the step if F is given
+template <bool WithJacobian>
+void transportBzImpl(SimdTrackParam& x, SimdMatrix<6, 6>* F, const simd_float& q,
+                     const simd_float& Bz, const simd_float& dS)
+{
+    const simd_float b = Bz * q * simd_float{ kCLight };
+    const simd_float bs = b * dS;
+    simd_float s, c;
+    sincos(bs, s, c);
+    // sin(bs) / b and (1 - cos(bs)) / b, expanded for vanishing field or step.
+    // 1 - cos is taken as sin^2 / (1 + cos) while cos > 0 to avoid cancellation.
+    const simd_float one{ 1.0f };
+    const simd_mask small = abs(bs) < simd_float{ 1e-4f };
+    const simd_float bSafe = select(small, one, b);
+    const simd_float oneMinusC = select(c > simd_float{ 0.0f }, s * s / (one + c), one - c);
+    const simd_float sSeries = fnmadd(bs * bs, simd_float{ 1.0f / 6.0f }, one) * dS;
+    const simd_float sB = select(small, sSeries, s / bSafe);
+    const simd_float cB = select(small, simd_float{ 0.5f } * sSeries * bs, oneMinusC / bSafe);
+
+    const simd_float px = x(3, 0);
+    const simd_float py = x(4, 0);
+    const simd_float pz = x(5, 0);
+    x(0, 0) = fmadd(sB, px, fmadd(cB, py, x(0, 0)));
+    x(1, 0) = fmadd(sB, py, fnmadd(cB, px, x(1, 0)));
+    x(2, 0) = fmadd(dS, pz, x(2, 0));
+    x(3, 0) = fmadd(c, px, s * py);
+    x(4, 0) = fnmadd(s, px, c * py);
+
+    if constexpr (WithJacobian) {
+        SimdMatrix<6, 6>& J = *F;
+        J = SimdMatrix<6, 6>::identity();
+        J(0, 3) = sB;
+        J(0, 4) = cB;
+        J(1, 3) = -cB;
+        J(1, 4) = sB;
+        J(2, 5) = dS;
+        J(3, 3) = c;
+        J(3, 4) = s;
+        J(4, 3) = -s;
+        J(4, 4) = c;
+    }
+}
+
+// Right-hand side of d(r, p)/dS = (p, k p x B(r)), k = c q
+template <typename Field>
+__KFP_SIMD__INLINE void rungeKuttaDerivative(const Field& field, const simd_float (&y)[6],
+                                             const simd_float& k, simd_float (&B)[3],
+                                             simd_float (&dy)[6])
+{
+    const simd_float xyz[3]{ y[0], y[1], y[2] };
+    field(xyz, B);
+    dy[0] = y[3];
+    dy[1] = y[4];
+    dy[2] = y[5];
+    dy[3] = k * fmsub(y[4], B[2], y[5] * B[1]);
+    dy[4] = k * fmsub(y[5], B[0], y[3] * B[2]);
+    dy[5] = k * fmsub(y[3], B[1], y[4] * B[0]);
+}
+
+template <bool WithCov, typename Field>
+void transportRungeKuttaImpl(SimdTrackParam& x, SimdTrackCov* C, const simd_float& q,
+                             const Field& field, const simd_float& dS, int nSteps)
+{
+    const simd_float k = q * simd_float{ kCLight };
+    const simd_float h = dS / simd_float{ float(nSteps) };
+    const simd_float h2 = h * simd_float{ 0.5f };
+    const simd_float h6 = h * simd_float{ 1.0f / 6.0f };
+    const simd_float weight[4]{ h6, h6 * simd_float{ 2.0f }, h6 * simd_float{ 2.0f }, h6 };
+    const simd_float stage[3]{ h2, h2, h };
+
+    simd_float y[6];
+    staticFor<6>([&](auto i) { y[i] = x(i, 0); });
+    // Jacobian d(y)/d(y0); the field gradient is neglected, so only the
+    // momentum rows feel the field: dJ_r/dS = J_p, dJ_p/dS = k J_p x B
+    SimdMatrix<6, 6> J = SimdMatrix<6, 6>::identity();
+
+    for (int iStep = 0; iStep < nSteps; ++iStep) {
+        simd_float yStage[6];
+        simd_float yNext[6];
+        simd_float dy[6];
+        simd_float B[3];
+        SimdMatrix<6, 6> JStage;
+        SimdMatrix<6, 6> JNext;
+        staticFor<6>([&](auto i) { yStage[i] = y[i]; yNext[i] = y[i]; });
+        if constexpr (WithCov) {
+            JStage = J;
+            JNext = J;
+        }
+        for (int iStage = 0; iStage < 4; ++iStage) {
+            rungeKuttaDerivative(field, yStage, k, B, dy);
+            staticFor<6>([&](auto i) { yNext[i] = fmadd(weight[iStage], dy[i], yNext[i]); });
+            if constexpr (WithCov) {
+                SimdMatrix<6, 6> dJ;
+                staticFor<6>([&](auto col) {
+                    const simd_float jx = JStage(3, col);
+                    const simd_float jy = JStage(4, col);
+                    const simd_float jz = JStage(5, col);
+                    dJ(0, col) = jx;
+                    dJ(1, col) = jy;
+                    dJ(2, col) = jz;
+                    dJ(3, col) = k * fmsub(jy, B[2], jz * B[1]);
+                    dJ(4, col) = k * fmsub(jz, B[0], jx * B[2]);
+                    dJ(5, col) = k * fmsub(jx, B[1], jy * B[0]);
+                });
+                staticFor<6>([&](auto row) {
+                    staticFor<6>([&](auto col) {
+                        JNext(row, col) = fmadd(weight[iStage], dJ(row, col), JNext(row, col));
+                        if (iStage < 3) {
+                            JStage(row, col) = fmadd(stage[iStage], dJ(row, col), J(row, col));
+                        }
+                    });
+                });
+            }
+            if (iStage < 3) {
+                staticFor<6>([&](auto i) { yStage[i] = fmadd(stage[iStage], dy[i], y[i]); });
+            }
+        }
+        staticFor<6>([&](auto i) { y[i] = yNext[i]; });
+        if constexpr (WithCov) {
+            J = JNext;
+        }
+    }
+    staticFor<6>([&](auto i) { x(i, 0) = y[i]; });
+    if constexpr (WithCov) {
+        *C = C->similarity(J);
+    }
+}
+
+} // namespace Detail
+
+// ------------------------------------------------------
+// Constant field along z: analytic helix
+// ------------------------------------------------------
+inline void transportBz(SimdTrackParam& x, const simd_float& q, const simd_float& Bz,
+                        const simd_float& dS)
+{
+    Detail::transportBzImpl<false>(x, nullptr, q, Bz, dS);
+}
+// Same, also transports the covariance with the Jacobian of the step
+inline void transportBz(SimdTrackParam& x, SimdTrackCov& C, const simd_float& q,
+                        const simd_float& Bz, const simd_float& dS)
+{
+    SimdMatrix<6, 6> F;
+    Detail::transportBzImpl<true>(x, &F, q, Bz, dS);
+    C = C.similarity(F);
+}
+
+// ------------------------------------------------------
+// Inhomogeneous field: 4th order Runge-Kutta
+// ------------------------------------------------------
+// field(const simd_float (&xyz)[3], simd_float (&B)[3]) returns the field in kG
+// at SimdLen points. The step dS is split in nSteps equal Runge-Kutta steps.
+template <typename Field>
+inline void transportRungeKutta(SimdTrackParam& x, const simd_float& q, const Field& field,
+                                const simd_float& dS, int nSteps = 1)
+{
+    Detail::transportRungeKuttaImpl<false>(x, nullptr, q, field, dS, nSteps);
+}
+template <typename Field>
+inline void transportRungeKutta(SimdTrackParam& x, SimdTrackCov& C, const simd_float& q,
+                                const Field& field, const simd_float& dS, int nSteps = 1)
+{
+    Detail::transportRungeKuttaImpl<true>(x, &C, q, field, dS, nSteps);
+}
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_EXTRAPOLATION_H
@@ -0,0 +1,208 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_FIELD_H
+#define SIMD_FIELD_H
+
+#include "../Math/simd_matrix.h"
+
+#include <cstring>
+#include <type_traits>
+
+// Polynomial approximations of the magnetic field as used by the KFParticle
+// and CBM track fitters. Both classes are field callbacks for
+// transportRungeKutta: operator()(const simd_float (&xyz)[3], simd_float (&B)[3]).
+
+namespace KFP {
+namespace SIMD {
+
+namespace Detail {
+
+// x^P by repeated squaring
+template <int P> __KFP_SIMD__INLINE simd_float power(const simd_float& x)
+{
+    if constexpr (P == 1) {
+        return x;
+    } else if constexpr (P % 2 == 0) {
+        const simd_float half = power<P / 2>(x);
+        return half * half;
+    } else {
+        return x * power<P - 1>(x);
+    }
+}
+
+// sum_{k < N} coef(k) x^k, coef called with std::integral_constant<int, Offset + k>.
+// Horner is a chain of N - 1 dependent FMAs and is used for short polynomials.
+template <int N, int Offset = 0, typename Coef>
+__KFP_SIMD__INLINE simd_float horner(const simd_float& x, const Coef& coef)
+{
+    if constexpr (N == 1) {
+        return coef(std::integral_constant<int, Offset>{});
+    } else {
+        return fmadd(horner<N - 1, Offset + 1>(x, coef), x,
+                     coef(std::integral_constant<int, Offset>{}));
+    }
+}
+
+// Estrin splits the polynomial at the largest power of two below N, so the
+// halves are evaluated independently: depth log2(N) instead of N - 1.
+template <int N, int Offset = 0, typename Coef>
+__KFP_SIMD__INLINE simd_float estrin(const simd_float& x, const Coef& coef)
+{
+    if constexpr (N <= 3) {
+        return horner<N, Offset>(x, coef);
+    } else {
+        constexpr int Split = (N > 8) ? 8 : ((N > 4) ? 4 : 2);
+        return fmadd(estrin<N - Split, Offset + Split>(x, coef), power<Split>(x),
+                     estrin<Split, Offset>(x, coef));
+    }
+}
+
+} // namespace Detail
+
+// ------------------------------------------------------
+// Field slice
+// ------------------------------------------------------
+// Field on a plane z = const as a polynomial of degree Degree in x and y. The
+// coefficients of each component are stored in graded order (1, x, y, x^2,
+// x y, y^2, x^3, ...), the layout of the CBM field slices: 21 coefficients for
+// degree 5. All lanes use the same slice, so coefficients are broadcast.
+template <int Degree> class SimdFieldSlice
+{
+public:
+    static_assert(Degree >= 0, "[Error] (KFP::SIMD::SimdFieldSlice): Invalid polynomial degree.");
+    static constexpr int NCoefficients{ (Degree + 1) * (Degree + 2) / 2 };
+
+    // Coefficient of x^i y^j
+    static constexpr int index(int i, int j)
+    {
+        return (i + j) * (i + j + 1) / 2 + j;
+    }
+
+    SimdFieldSlice()
+    {
+        std::memset(coefficients_, 0, sizeof(coefficients_));
+    }
+    // cx, cy and cz point to NCoefficients values each
+    SimdFieldSlice(const float* cx, const float* cy, const float* cz)
+    {
+        std::memcpy(coefficients_[0], cx, sizeof(coefficients_[0]));
+        std::memcpy(coefficients_[1], cy, sizeof(coefficients_[1]));
+        std::memcpy(coefficients_[2], cz, sizeof(coefficients_[2]));
+    }
+
+    float* coefficients(int component)
+    {
+        return coefficients_[component];
+    }
+    const float* coefficients(int component) const
+    {
+        return coefficients_[component];
+    }
+
+    // B = sum_i x^i (sum_j c_ij y^j): Estrin in y for every power of x, Horner in x
+    void get(const simd_float& x, const simd_float& y, simd_float (&B)[3]) const
+    {
+        Detail::staticFor<3>([&](auto component) {
+            const float* c = coefficients_[component];
+            B[component] = Detail::horner<Degree + 1>(x, [&](auto i) {
+                return Detail::estrin<Degree - i + 1>(
+                    y, [&](auto j) { return simd_float{ c[index(i, j)] }; });
+            });
+        });
+    }
+    void operator()(const simd_float (&xyz)[3], simd_float (&B)[3]) const
+    {
+        get(xyz[0], xyz[1], B);
+    }
+
+private:
+    alignas(__KFP_SIMD__Size_Float) float coefficients_[3][static_cast<std::size_t>(NCoefficients)];
+};
+
+// ------------------------------------------------------
+// Field region
+// ------------------------------------------------------
+// Field along the track of every lane as a parabola in z around z0:
+//   B(z) = c0 + c1 (z - z0) + c2 (z - z0)^2
+// built from field values at two or three z positions per lane.
+class SimdFieldRegion
+{
+public:
+    SimdFieldRegion() : z0_{ 0.0f }
+    {
+        Detail::staticFor<3>([&](auto component) {
+            Detail::staticFor<3>([&](auto k) { c_[component][k] = simd_float{ 0.0f }; });
+        });
+    }
+
+    // Parabola through (z0, B0), (z1, B1), (z2, B2); the z must differ
+    void set(const simd_float (&B0)[3], const simd_float& z0, const simd_float (&B1)[3],
+             const simd_float& z1, const simd_float (&B2)[3], const simd_float& z2)
+    {
+        const simd_float dz1 = z1 - z0;
+        const simd_float dz2 = z2 - z0;
+        const simd_float det = simd_float{ 1.0f } / (dz1 * dz2 * (z2 - z1));
+        const simd_float w21 = -dz2 * det;
+        const simd_float w22 = dz1 * det;
+        const simd_float w11 = -dz2 * w21;
+        const simd_float w12 = -dz1 * w22;
+        Detail::staticFor<3>([&](auto component) {
+            const simd_float dB1 = B1[component] - B0[component];
+            const simd_float dB2 = B2[component] - B0[component];
+            c_[component][0] = B0[component];
+            c_[component][1] = fmadd(dB1, w11, dB2 * w12);
+            c_[component][2] = fmadd(dB1, w21, dB2 * w22);
+        });
+        z0_ = z0;
+    }
+    // Straight line through (z0, B0) and (z1, B1)
+    void set(const simd_float (&B0)[3], const simd_float& z0, const simd_float (&B1)[3],
+             const simd_float& z1)
+    {
+        const simd_float dzInv = simd_float{ 1.0f } / (z1 - z0);
+        Detail::staticFor<3>([&](auto component) {
+            c_[component][0] = B0[component];
+            c_[component][1] = (B1[component] - B0[component]) * dzInv;
+            c_[component][2] = simd_float{ 0.0f };
+        });
+        z0_ = z0;
+    }
+
+    void get(const simd_float& z, simd_float (&B)[3]) const
+    {
+        const simd_float dz = z - z0_;
+        Detail::staticFor<3>([&](auto component) {
+            B[component] = fmadd(fmadd(c_[component][2], dz, c_[component][1]), dz,
+                                 c_[component][0]);
+        });
+    }
+    void operator()(const simd_float (&xyz)[3], simd_float (&B)[3]) const
+    {
+        get(xyz[2], B);
+    }
+
+    // Coefficient k of component, and the expansion point
+    const simd_float& coefficient(int component, int k) const
+    {
+        return c_[component][k];
+    }
+    const simd_float& z0() const
+    {
+        return z0_;
+    }
+
+private:
+    simd_float c_[3][3];
+    simd_float z0_;
+};
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_FIELD_H
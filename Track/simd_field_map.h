@@ -0,0 +1,137 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_FIELD_MAP_H
+#define SIMD_FIELD_MAP_H
+
+#include "../simd.h"
+
+#include <cassert>
+#include <string>
+
+namespace KFP {
+namespace SIMD {
+
+// Field on a regular 3D grid with trilinear interpolation. Every component is
+// a separate aligned column (SoA), node (ix, iy, iz) at (ix * ny + iy) * nz + iz.
+// The interpolator looks up SimdLen points at once: cell indices are computed
+// with simd_int, the 8 corners of each component are gathered and blended
+// with FMA. Points outside the grid get a zero field and a cleared mask lane.
+class SimdFieldMap
+{
+public:
+    typedef Vector<float, simd_float::SimdSize> column_type;
+
+    SimdFieldMap(int nx, int ny, int nz, const float (&min)[3], const float (&step)[3])
+        : n_{ nx, ny, nz }, min_{ min[0], min[1], min[2] },
+          stepInv_{ 1.0f / step[0], 1.0f / step[1], 1.0f / step[2] }, step_{ step[0], step[1], step[2] }
+    {
+        assert(((nx > 1) && (ny > 1) && (nz > 1)) &&
+               (std::string{ "[Error] (KFP::SIMD::SimdFieldMap): Grid needs at least two nodes per axis, given: " } +
+                std::to_string(nx) + ", " + std::to_string(ny) + ", " + std::to_string(nz))
+                   .data());
+        const std::size_t nNodes =
+            static_cast<std::size_t>(nx) * static_cast<std::size_t>(ny) * static_cast<std::size_t>(nz);
+        for (column_type& column : columns_) {
+            column.assign(nNodes, 0.0f);
+        }
+    }
+
+    int size(int axis) const
+    {
+        return n_[axis];
+    }
+    int index(int ix, int iy, int iz) const
+    {
+        return (ix * n_[1] + iy) * n_[2] + iz;
+    }
+    // Position of node i along axis
+    float node(int axis, int i) const
+    {
+        return min_[axis] + float(i) * step_[axis];
+    }
+
+    float* component(int c)
+    {
+        return columns_[c].data();
+    }
+    const float* component(int c) const
+    {
+        return columns_[c].data();
+    }
+    void set(int ix, int iy, int iz, float bx, float by, float bz)
+    {
+        const std::size_t idx = static_cast<std::size_t>(index(ix, iy, iz));
+        columns_[0][idx] = bx;
+        columns_[1][idx] = by;
+        columns_[2][idx] = bz;
+    }
+
+    // ------------------------------------------------------
+    // Interpolation
+    // ------------------------------------------------------
+    simd_mask get(const simd_float& x, const simd_float& y, const simd_float& z,
+                  simd_float (&B)[3]) const
+    {
+        const simd_float pos[3]{ x, y, z };
+        simd_mask inside{ true };
+        simd_int cell[3];
+        simd_float frac[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            const simd_float u = (pos[axis] - min_[axis]) * stepInv_[axis];
+            const simd_float last{ float(n_[axis] - 1) };
+            const simd_mask in = (u >= simd_float{ 0.0f }) && (u <= last);
+            inside &= in;
+            // Outside lanes (and NaN) are moved to node 0 so every index is valid
+            const simd_float uSafe = select(in, u, simd_float{ 0.0f });
+            cell[axis] = min(simd_int{ uSafe }, simd_int{ n_[axis] - 2 });
+            frac[axis] = uSafe - simd_float{ cell[axis] };
+        }
+        const int strideY = n_[2];
+        const int strideX = n_[1] * n_[2];
+        const simd_int i000 = (cell[0] * simd_int{ n_[1] } + cell[1]) * simd_int{ n_[2] } + cell[2];
+        const simd_int i010 = i000 + simd_int{ strideY };
+        const simd_int i100 = i000 + simd_int{ strideX };
+        const simd_int i110 = i100 + simd_int{ strideY };
+        const simd_int one{ 1 };
+        const simd_float zero{ 0.0f };
+        for (int c = 0; c < 3; ++c) {
+            const float* column = columns_[c].data();
+            const simd_float c00 = lerp(simd_float{}.gather(column, i000), simd_float{}.gather(column, i000 + one), frac[2]);
+            const simd_float c01 = lerp(simd_float{}.gather(column, i010), simd_float{}.gather(column, i010 + one), frac[2]);
+            const simd_float c10 = lerp(simd_float{}.gather(column, i100), simd_float{}.gather(column, i100 + one), frac[2]);
+            const simd_float c11 = lerp(simd_float{}.gather(column, i110), simd_float{}.gather(column, i110 + one), frac[2]);
+            const simd_float c0 = lerp(c00, c01, frac[1]);
+            const simd_float c1 = lerp(c10, c11, frac[1]);
+            B[c] = select(inside, lerp(c0, c1, frac[0]), zero);
+        }
+        return inside;
+    }
+    // Field callback for transportRungeKutta
+    void operator()(const simd_float (&xyz)[3], simd_float (&B)[3]) const
+    {
+        get(xyz[0], xyz[1], xyz[2], B);
+    }
+
+private:
+    static simd_float lerp(const simd_float& a, const simd_float& b, const simd_float& t)
+    {
+        return fmadd(t, b - a, a);
+    }
+
+    int n_[3];
+    float min_[3];
+    float stepInv_[3];
+    float step_[3];
+    column_type columns_[3];
+};
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_FIELD_MAP_H
@@ -0,0 +1,114 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef SIMD_KALMAN_H
+#define SIMD_KALMAN_H
+
+#include "../Math/simd_cholesky.h"
+#include "../Math/simd_matrix.h"
+
+namespace KFP {
+namespace SIMD {
+
+// State vector, covariance and fit quality of SimdLen tracks
+template <int N> struct SimdTrackState
+{
+    SimdMatrix<N, 1> x{};
+    SimdSymMatrix<N> C{};
+    simd_float chi2{ 0.0f };
+    simd_int ndf{ 0 };
+};
+
+// Measurement of state components Idx... (H is a pure projection)
+template <int... Idx> struct SimdProjection
+{
+    static constexpr int Dim{ sizeof...(Idx) };
+    static constexpr int index[sizeof...(Idx)]{ Idx... };
+};
+
+namespace Detail {
+
+// Common part of the update, given H x, C H^T and H C H^T + V:
+//   r = m - H x, S = V + H C H^T, K = C H^T S^-1
+//   x += K r, C -= K (C H^T)^T, chi2 += r^T S^-1 r, ndf += M
+// Lanes outside active, or with S not positive definite, keep their track.
+template <int N, int M>
+simd_mask kalmanUpdateImpl(SimdTrackState<N>& track, const SimdMatrix<M, 1>& Hx,
+                           const SimdMatrix<N, M>& CHt, const SimdSymMatrix<M>& S,
+                           const SimdMatrix<M, 1>& m, const simd_mask& active)
+{
+    const SimdCholesky<M> cholesky{ S };
+    const simd_mask apply = active && cholesky.valid();
+
+    SimdMatrix<M, 1> r;
+    staticFor<M>([&](auto k) { r(k, 0) = m(k, 0) - Hx(k, 0); });
+    const SimdMatrix<M, 1> Sr = cholesky.solve(r);
+    // K^T = S^-1 (C H^T)^T
+    const SimdMatrix<M, N> Kt = cholesky.solve(CHt.transpose());
+
+    staticFor<N>([&](auto i) {
+        simd_float xi = track.x(i, 0);
+        staticFor<M>([&](auto k) { xi = fmadd(Kt(k, i), r(k, 0), xi); });
+        track.x(i, 0) = select(apply, xi, track.x(i, 0));
+        staticFor<i + 1>([&](auto j) {
+            simd_float cij = track.C(i, j);
+            staticFor<M>([&](auto k) { cij = fnmadd(Kt(k, i), CHt(j, k), cij); });
+            track.C(i, j) = select(apply, cij, track.C(i, j));
+        });
+    });
+    simd_float dchi2 = r(0, 0) * Sr(0, 0);
+    staticFor<M - 1>([&](auto k) { dchi2 = fmadd(r(k + 1, 0), Sr(k + 1, 0), dchi2); });
+    track.chi2 = select(apply, track.chi2 + dchi2, track.chi2);
+    track.ndf = select(apply, track.ndf + simd_int{ M }, track.ndf);
+    return apply;
+}
+
+} // namespace Detail
+
+// ------------------------------------------------------
+// Measurement update
+// ------------------------------------------------------
+// Applies the measurement m with covariance V and projection H to the lanes
+// set in active. Returns the lanes which were updated.
+template <int N, int M>
+inline simd_mask kalmanUpdate(SimdTrackState<N>& track, const SimdMatrix<M, N>& H,
+                              const SimdMatrix<M, 1>& m, const SimdSymMatrix<M>& V,
+                              const simd_mask& active = simd_mask{ true })
+{
+    const SimdMatrix<N, M> CHt = track.C.multiply(H.transpose());
+    return Detail::kalmanUpdateImpl(track, H * track.x, CHt, track.C.similarity(H).add(V), m,
+                                    active);
+}
+
+// Same for H selecting state components: H x, C H^T and H C H^T are plain
+// element lookups, no multiplication is needed.
+template <int N, int... Idx>
+inline simd_mask kalmanUpdate(SimdTrackState<N>& track, SimdProjection<Idx...>,
+                              const SimdMatrix<sizeof...(Idx), 1>& m,
+                              const SimdSymMatrix<sizeof...(Idx)>& V,
+                              const simd_mask& active = simd_mask{ true })
+{
+    constexpr int M = sizeof...(Idx);
+    using projection = SimdProjection<Idx...>;
+    SimdMatrix<M, 1> Hx;
+    SimdMatrix<N, M> CHt;
+    SimdSymMatrix<M> S;
+    Detail::staticFor<M>([&](auto k) {
+        Hx(k, 0) = track.x(projection::index[k], 0);
+        Detail::staticFor<N>([&](auto i) { CHt(i, k) = track.C(i, projection::index[k]); });
+        Detail::staticFor<k + 1>([&](auto l) {
+            S(k, l) = track.C(projection::index[k], projection::index[l]) + V(k, l);
+        });
+    });
+    return Detail::kalmanUpdateImpl(track, Hx, CHt, S, m, active);
+}
+
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !SIMD_KALMAN_H
@@ -12,6 +12,10 @@ Emails: mithran@fias.uni-frankfurt.de
 // Determine instruction set, and define platform-dependent functions
 #include "Base/simd_macros.h"
 #include "Base/simd_allocate.h"
+#include "Base/simd_arena.h"
+#include "Base/simd_pool.h"
+#include "Base/simd_hugepage.h"
+#include "Base/simd_buffer.h"
 
 // Select appropriate header files depending on instruction set
 #if defined(__KFP_SIMD__AVX)
@@ -19,10 +23,18 @@ Emails: mithran@fias.uni-frankfurt.de
 #elif defined(__KFP_SIMD__SSE)
 #include "SSE/simd_sse.h"
 #else
-#error "[Error] (simd.h): KFParticle SIMD Scalar not implemented."
 #include "Scalar/simd_scalar.h"
 #endif
 
+// Backend independent algorithms on top of simd_float/simd_int
+#include "Base/simd_algorithm.h"
+#include "Base/simd_soa.h"
+#include "Base/simd_aosoa.h"
+#include "Base/simd_struct.h"
+#include "Base/simd_vector.h"
+#include "Base/simd_stream.h"
+#include "Base/simd_prefetch.h"
+
 static_assert(
     (KFP::SIMD::simd_float::SimdSize == __KFP_SIMD__Size_Float),
     "[Error]: KFP::SIMD::simd_float given invalid size of simd type.");
@@ -0,0 +1,325 @@
+// -*- C++ Header -*-
+/*
+==================================================
+Authors: A.Mithran;
+Emails: mithran@fias.uni-frankfurt.de
+==================================================
+*/
+
+#ifndef KFP_SIMD_EXPR_H
+#define KFP_SIMD_EXPR_H
+
+#include "simd.h"
+
+#include <type_traits>
+
+// Optional expression-template layer. The regular operators of simd_float
+// evaluate eagerly and are left untouched; wrapping an operand with
+// KFP::SIMD::Expr::lazy() instead builds an expression which is lowered when
+// it is converted back to simd_float:
+//
+//   simd_float r = lazy(a) * b + c;          // fmadd(a, b, c)
+//   simd_float r = lazy(a) * b - c;          // fmsub(a, b, c)
+//   simd_float r = -(lazy(a) * b) + c;       // fnmadd(a, b, c)
+//   simd_float r = c - lazy(a) * b;          // fnmadd(a, b, c)
+//   simd_float r = select(m, lazy(a) + b, a); // a + (b & m)
+//
+// Fused forms round once, so results may differ from the eager operators in
+// the last bit. Expressions are meant to be consumed within the full
+// expression that creates them; do not keep them in auto variables.
+
+namespace KFP {
+namespace SIMD {
+namespace Expr {
+
+// ------------------------------------------------------
+// Expression nodes
+// ------------------------------------------------------
+template <typename Derived, typename T> class Expression
+{
+public:
+    typedef T result_type;
+
+    const Derived& self() const
+    {
+        return static_cast<const Derived&>(*this);
+    }
+    T eval() const
+    {
+        return self().eval();
+    }
+    operator T() const
+    {
+        return self().eval();
+    }
+};
+
+// Operand wrapper. The address of the wrapped object is kept only to recognise
+// select(m, a + b, a), the value is what gets evaluated.
+template <typename T> class Leaf : public Expression<Leaf<T>, T>
+{
+public:
+    Leaf(const T& value, const void* origin) : value_{ value }, origin_{ origin } {}
+    T eval() const
+    {
+        return value_;
+    }
+    const void* origin() const
+    {
+        return origin_;
+    }
+
+private:
+    T value_;
+    const void* origin_;
+};
+
+template <typename T, typename A> class Neg : public Expression<Neg<T, A>, T>
+{
+public:
+    explicit Neg(const A& arg) : arg_{ arg } {}
+    const A& arg() const
+    {
+        return arg_;
+    }
+    T eval() const;
+
+private:
+    A arg_;
+};
+
+#define KFP_SIMD_EXPR_BINARY_NODE(Node)                                        \
+    template <typename T, typename L, typename R>                              \
+    class Node : public Expression<Node<T, L, R>, T>                           \
+    {                                                                          \
+    public:                                                                    \
+        Node(const L& lhs, const R& rhs) : lhs_{ lhs }, rhs_{ rhs } {}         \
+        const L& lhs() const                                                   \
+        {                                                                      \
+            return lhs_;                                                       \
+        }                                                                      \
+        const R& rhs() const                                                   \
+        {                                                                      \
+            return rhs_;                                                       \
+        }                                                                      \
+        T eval() const;                                                        \
+                                                                               \
+    private:                                                                   \
+        L lhs_;                                                                \
+        R rhs_;                                                                \
+    };
+
+KFP_SIMD_EXPR_BINARY_NODE(Add)
+KFP_SIMD_EXPR_BINARY_NODE(Sub)
+KFP_SIMD_EXPR_BINARY_NODE(Mul)
+KFP_SIMD_EXPR_BINARY_NODE(Div)
+#undef KFP_SIMD_EXPR_BINARY_NODE
+
+// ------------------------------------------------------
+// Pattern traits
+// ------------------------------------------------------
+template <typename E> struct IsMul : std::false_type
+{
+};
+template <typename T, typename L, typename R>
+struct IsMul<Mul<T, L, R>> : std::true_type
+{
+};
+template <typename E> struct IsNegMul : std::false_type
+{
+};
+template <typename T, typename L, typename R>
+struct IsNegMul<Neg<T, Mul<T, L, R>>> : std::true_type
+{
+};
+
+// ------------------------------------------------------
+// Lowering
+// ------------------------------------------------------
+template <typename T, typename A> inline T Neg<T, A>::eval() const
+{
+    return -arg_.eval();
+}
+
+template <typename T, typename L, typename R> inline T Add<T, L, R>::eval() const
+{
+    if constexpr (IsMul<L>::value) {
+        return fmadd(lhs_.lhs().eval(), lhs_.rhs().eval(), rhs_.eval());
+    } else if constexpr (IsMul<R>::value) {
+        return fmadd(rhs_.lhs().eval(), rhs_.rhs().eval(), lhs_.eval());
+    } else if constexpr (IsNegMul<L>::value) {
+        return fnmadd(lhs_.arg().lhs().eval(), lhs_.arg().rhs().eval(), rhs_.eval());
+    } else if constexpr (IsNegMul<R>::value) {
+        return fnmadd(rhs_.arg().lhs().eval(), rhs_.arg().rhs().eval(), lhs_.eval());
+    } else {
+        return lhs_.eval() + rhs_.eval();
+    }
+}
+
+template <typename T, typename L, typename R> inline T Sub<T, L, R>::eval() const
+{
+    if constexpr (IsMul<L>::value) {
+        return fmsub(lhs_.lhs().eval(), lhs_.rhs().eval(), rhs_.eval());
+    } else if constexpr (IsNegMul<L>::value) {
+        return fnmsub(lhs_.arg().lhs().eval(), lhs_.arg().rhs().eval(), rhs_.eval());
+    } else if constexpr (IsMul<R>::value) {
+        return fnmadd(rhs_.lhs().eval(), rhs_.rhs().eval(), lhs_.eval());
+    } else {
+        return lhs_.eval() - rhs_.eval();
+    }
+}
+
+template <typename T, typename L, typename R> inline T Mul<T, L, R>::eval() const
+{
+    return lhs_.eval() * rhs_.eval();
+}
+
+template <typename T, typename L, typename R> inline T Div<T, L, R>::eval() const
+{
+    return lhs_.eval() / rhs_.eval();
+}
+
+// ------------------------------------------------------
+// Entry points
+// ------------------------------------------------------
+template <typename ValueType, Tag tag>
+inline Leaf<SimdClassBase<ValueType, tag>> lazy(const SimdClassBase<ValueType, tag>& a)
+{
+    return Leaf<SimdClassBase<ValueType, tag>>{ a, &a };
+}
+
+template <typename Derived, typename T>
+inline T evaluate(const Expression<Derived, T>& expr)
+{
+    return expr.eval();
+}
+
+// Operands of an expression: nodes are kept as they are, vectors and broadcast
+// values become leaves.
+template <typename Derived, typename T>
+inline const Derived& operand(const Expression<Derived, T>& expr)
+{
+    return expr.self();
+}
+template <typename T> inline Leaf<T> operand(const T& a)
+{
+    return Leaf<T>{ a, &a };
+}
+template <typename T> inline Leaf<T> operand(typename T::value_type val)
+{
+    return Leaf<T>{ T{ val }, nullptr };
+}
+
+// ------------------------------------------------------
+// Operators
+// ------------------------------------------------------
+template <typename T, typename A>
+inline Neg<T, A> operator-(const Expression<A, T>& a)
+{
+    return Neg<T, A>{ a.self() };
+}
+
+#define KFP_SIMD_EXPR_BINARY_OPERATOR(op, Node)                                \
+    template <typename T, typename L, typename R>                              \
+    inline Node<T, L, R> operator op(const Expression<L, T>& a,                \
+                                     const Expression<R, T>& b)                \
+    {                                                                          \
+        return Node<T, L, R>{ a.self(), b.self() };                            \
+    }                                                                          \
+    template <typename T, typename L>                                          \
+    inline Node<T, L, Leaf<T>> operator op(const Expression<L, T>& a,          \
+                                           const T& b)                         \
+    {                                                                          \
+        return Node<T, L, Leaf<T>>{ a.self(), operand<T>(b) };                 \
+    }                                                                          \
+    template <typename T, typename R>                                          \
+    inline Node<T, Leaf<T>, R> operator op(const T& a,                         \
+                                           const Expression<R, T>& b)          \
+    {                                                                          \
+        return Node<T, Leaf<T>, R>{ operand<T>(a), b.self() };                 \
+    }                                                                          \
+    template <typename T, typename L>                                          \
+    inline Node<T, L, Leaf<T>> operator op(const Expression<L, T>& a,          \
+                                           typename T::value_type b)           \
+    {                                                                          \
+        return Node<T, L, Leaf<T>>{ a.self(), operand<T>(b) };                 \
+    }                                                                          \
+    template <typename T, typename R>                                          \
+    inline Node<T, Leaf<T>, R> operator op(typename T::value_type a,           \
+                                           const Expression<R, T>& b)          \
+    {                                                                          \
+        return Node<T, Leaf<T>, R>{ operand<T>(a), b.self() };                 \
+    }
+
+KFP_SIMD_EXPR_BINARY_OPERATOR(+, Add)
+KFP_SIMD_EXPR_BINARY_OPERATOR(-, Sub)
+KFP_SIMD_EXPR_BINARY_OPERATOR(*, Mul)
+KFP_SIMD_EXPR_BINARY_OPERATOR(/, Div)
+#undef KFP_SIMD_EXPR_BINARY_OPERATOR
+
+// ------------------------------------------------------
+// Masked forms
+// ------------------------------------------------------
+// select(m, a + b, a) and select(m, a - b, a) only touch the lanes of b that
+// are set in the mask: a + (b & m) replaces an add and a blend by an add and a
+// bitwise and. Lanes outside the mask compute a + 0, which turns -0 into +0.
+template <typename ValueType, Tag tag>
+inline SimdClassBase<ValueType, tag> maskedOperand(const SimdMaskBase<tag>& mask,
+                                                   const SimdClassBase<ValueType, tag>& b)
+{
+    using simd_type = typename SimdClassBase<ValueType, tag>::simd_type;
+    using simd_typei = typename SimdMaskBase<tag>::simd_typei;
+    return SimdClassBase<ValueType, tag>{ Detail::type_cast<simd_type, simd_typei>(
+        Detail::ANDBits<simd_typei>(mask.maski(),
+                                    Detail::type_cast<simd_typei, simd_type>(b.simd()))) };
+}
+
+template <typename T, typename L, typename R, Tag tag>
+inline T select(const SimdMaskBase<tag>& mask, const Add<T, L, R>& sum, const T& a)
+{
+    if constexpr (std::is_same<L, Leaf<T>>::value) {
+        if (sum.lhs().origin() == &a) {
+            return a + maskedOperand(mask, sum.rhs().eval());
+        }
+    }
+    if constexpr (std::is_same<R, Leaf<T>>::value) {
+        if (sum.rhs().origin() == &a) {
+            return a + maskedOperand(mask, sum.lhs().eval());
+        }
+    }
+    return select(mask, sum.eval(), a);
+}
+
+template <typename T, typename L, typename R, Tag tag>
+inline T select(const SimdMaskBase<tag>& mask, const Sub<T, L, R>& diff, const T& a)
+{
+    if constexpr (std::is_same<L, Leaf<T>>::value) {
+        if (diff.lhs().origin() == &a) {
+            return a - maskedOperand(mask, diff.rhs().eval());
+        }
+    }
+    return select(mask, diff.eval(), a);
+}
+
+template <typename T, typename A, typename B, Tag tag>
+inline T select(const SimdMaskBase<tag>& mask, const Expression<A, T>& a,
+                const Expression<B, T>& b)
+{
+    return select(mask, a.eval(), b.eval());
+}
+template <typename T, typename A, Tag tag>
+inline T select(const SimdMaskBase<tag>& mask, const Expression<A, T>& a, const T& b)
+{
+    return select(mask, a.eval(), b);
+}
+template <typename T, typename B, Tag tag>
+inline T select(const SimdMaskBase<tag>& mask, const T& a, const Expression<B, T>& b)
+{
+    return select(mask, a, b.eval());
+}
+
+} // namespace Expr
+} // namespace SIMD
+} // namespace KFP
+
+#endif // !KFP_SIMD_EXPR_H